@@ -0,0 +1,202 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "boring_json.h"
+#include "boring_json_simple_writer.h"
+#include "boring_json_buffered_writer.h"
+#include "boring_json_parallel.h"
+
+#define BENCH_N_VALUES (100000)
+#define BENCH_ROUNDS   (20)
+#define BENCH_THREADS  (4)
+
+struct ints {
+	int values[BENCH_N_VALUES];
+	size_t values_count;
+};
+
+struct int64s {
+	int64_t values[BENCH_N_VALUES];
+	size_t values_count;
+};
+
+struct doubles {
+	double values[BENCH_N_VALUES];
+	size_t values_count;
+};
+
+enum bench_kind {
+	BENCH_KIND_INT,
+	BENCH_KIND_INT64,
+	BENCH_KIND_DOUBLE,
+};
+
+static const struct bo_json_value_desc ints_desc = BO_JSON_VALUE_STRUCT_ARRAY(
+	struct ints, values, &bo_json_int_desc, BENCH_N_VALUES, values_count);
+static const struct bo_json_value_desc int64s_desc = BO_JSON_VALUE_STRUCT_ARRAY(
+	struct int64s, values, &bo_json_int64_desc, BENCH_N_VALUES, values_count);
+static const struct bo_json_value_desc doubles_desc = BO_JSON_VALUE_STRUCT_ARRAY(
+	struct doubles, values, &bo_json_double_desc, BENCH_N_VALUES, values_count);
+static const struct bo_json_value_desc fixed_double_desc = BO_JSON_VALUE_DOUBLE_FIXED(2);
+static const struct bo_json_value_desc fixed_doubles_desc = BO_JSON_VALUE_STRUCT_ARRAY(
+	struct doubles, values, &fixed_double_desc, BENCH_N_VALUES, values_count);
+
+static struct ints g_ints;
+static struct int64s g_int64s;
+static struct doubles g_doubles;
+static char g_buf[BENCH_N_VALUES * 32];
+
+static double now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((double)ts.tv_sec * 1e9) + (double)ts.tv_nsec;
+}
+
+/**
+ * @brief Produce the same array as the encoder with one snprintf() per value
+ *
+ * This is what encode_int()/encode_int64()/encode_double() used to do and serves as the baseline.
+ */
+static struct bo_json_error encode_snprintf(const void *in, enum bench_kind kind,
+					    struct bo_json_writer *writer)
+{
+	const size_t count = BENCH_N_VALUES;
+	struct bo_json_error err = bo_json_writer_write(writer, "[", 1);
+
+	for (size_t i = 0; i < count && err.err == BO_JSON_ERROR_NONE; i++) {
+		char number_str[26];
+		int len;
+
+		switch (kind) {
+		case BENCH_KIND_INT:
+			len = snprintf(number_str, sizeof(number_str), "%d",
+				       ((const struct ints *)in)->values[i]);
+			break;
+		case BENCH_KIND_INT64:
+			len = snprintf(number_str, sizeof(number_str), "%" PRIi64,
+				       ((const struct int64s *)in)->values[i]);
+			break;
+		default:
+			len = snprintf(number_str, sizeof(number_str), "%1.15g",
+				       ((const struct doubles *)in)->values[i]);
+			break;
+		}
+		err = bo_json_writer_write(writer, number_str, (size_t)len);
+		if (err.err == BO_JSON_ERROR_NONE && i < count - 1) {
+			err = bo_json_writer_write(writer, ",", 1);
+		}
+	}
+
+	if (err.err != BO_JSON_ERROR_NONE) {
+		return err;
+	}
+	return bo_json_writer_write(writer, "]", 1);
+}
+
+static void report(const char *name, double elapsed_ns, size_t bytes)
+{
+	printf("%-28s %8.2f ns/value %8.1f MB/s\n", name,
+	       elapsed_ns / ((double)BENCH_N_VALUES * BENCH_ROUNDS),
+	       ((double)bytes * BENCH_ROUNDS * 1e3) / elapsed_ns);
+}
+
+static int bench_array(const char *name, const void *in, const struct bo_json_value_desc *desc,
+		       enum bench_kind kind)
+{
+	struct bo_json_simple_writer writer;
+	struct bo_json_error err = BO_JSON_OK();
+	double start;
+
+	start = now_ns();
+	for (int round = 0; round < BENCH_ROUNDS && err.err == BO_JSON_ERROR_NONE; round++) {
+		bo_json_simple_writer_init(&writer, g_buf, sizeof(g_buf));
+		err = encode_snprintf(in, kind, &writer.ctx);
+	}
+	if (err.err != BO_JSON_ERROR_NONE) {
+		return -1;
+	}
+	char label[64];
+
+	snprintf(label, sizeof(label), "%s snprintf", name);
+	report(label, now_ns() - start, writer.len);
+
+	start = now_ns();
+	for (int round = 0; round < BENCH_ROUNDS && err.err == BO_JSON_ERROR_NONE; round++) {
+		bo_json_simple_writer_init(&writer, g_buf, sizeof(g_buf));
+		err = bo_json_encode(in, desc, &writer.ctx);
+	}
+	if (err.err != BO_JSON_ERROR_NONE) {
+		return -1;
+	}
+	snprintf(label, sizeof(label), "%s bo_json", name);
+	report(label, now_ns() - start, writer.len);
+
+	// the same callback sink behind a buffered writer
+	struct bo_json_buffered_writer buffered;
+	static char chunk[4096];
+
+	start = now_ns();
+	for (int round = 0; round < BENCH_ROUNDS && err.err == BO_JSON_ERROR_NONE; round++) {
+		bo_json_simple_writer_init(&writer, g_buf, sizeof(g_buf));
+		bo_json_buffered_writer_init(&buffered, &writer.ctx, chunk, sizeof(chunk));
+		err = bo_json_encode(in, desc, &buffered.ctx);
+		if (err.err == BO_JSON_ERROR_NONE) {
+			err = bo_json_buffered_writer_flush(&buffered);
+		}
+	}
+	if (err.err != BO_JSON_ERROR_NONE) {
+		return -1;
+	}
+	snprintf(label, sizeof(label), "%s bo_json buffered", name);
+	report(label, now_ns() - start, writer.len);
+
+	// wall clock time, the array split between threads
+	start = now_ns();
+	for (int round = 0; round < BENCH_ROUNDS && err.err == BO_JSON_ERROR_NONE; round++) {
+		bo_json_simple_writer_init(&writer, g_buf, sizeof(g_buf));
+		err = bo_json_encode_parallel(in, desc, BENCH_THREADS, &writer.ctx);
+	}
+	if (err.err != BO_JSON_ERROR_NONE) {
+		return -1;
+	}
+	snprintf(label, sizeof(label), "%s bo_json %d threads", name, BENCH_THREADS);
+	report(label, now_ns() - start, writer.len);
+
+	return 0;
+}
+
+int main(void)
+{
+	srand(1);
+
+	// mixed magnitudes, so every digit count shows up
+	for (size_t i = 0; i < BENCH_N_VALUES; i++) {
+		const int shift = rand() % 31;
+		const int64_t wide = ((int64_t)rand() << 32) | (int64_t)rand();
+
+		g_ints.values[i] = (rand() >> shift) * ((i & 1) ? -1 : 1);
+		g_int64s.values[i] = (wide >> (rand() % 63)) * ((i & 1) ? -1 : 1);
+		// metric like values: a few significant digits over a wide range
+		g_doubles.values[i] = (double)(rand() % 100000) / (double)(1 << (rand() % 24));
+	}
+	g_ints.values_count = BENCH_N_VALUES;
+	g_int64s.values_count = BENCH_N_VALUES;
+	g_doubles.values_count = BENCH_N_VALUES;
+
+	if (bench_array("int[]", &g_ints, &ints_desc, BENCH_KIND_INT) != 0 ||
+	    bench_array("int64_t[]", &g_int64s, &int64s_desc, BENCH_KIND_INT64) != 0 ||
+	    bench_array("double[]", &g_doubles, &doubles_desc, BENCH_KIND_DOUBLE) != 0 ||
+	    bench_array("fixed2[]", &g_doubles, &fixed_doubles_desc, BENCH_KIND_DOUBLE) != 0) {
+		fprintf(stderr, "encode failed\n");
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -1,6 +1,7 @@
 option(CONFIG_BORING_JSON_DEBUG "Enable debug print" OFF)
 option(CONFIG_BORING_JSON_TESTING "Build testing" OFF)
 option(CONFIG_BORING_JSON_TEST_SANITIZERS "Enable Clang sanitizers for runtime tests" OFF)
+option(CONFIG_BORING_JSON_BENCHMARK "Build micro-benchmarks" OFF)
 
 if(CONFIG_BORING_JSON_TEST_SANITIZERS)
   if(NOT CONFIG_BORING_JSON_TESTING)
@@ -16,7 +17,13 @@ if(CONFIG_BORING_JSON_TEST_SANITIZERS)
   endif()
 endif()
 
-add_library(boring_json ${SOURCES})
+find_package(Threads REQUIRED)
+
+add_library(boring_json ${SOURCES}
+            ${BORING_JSON_ROOT_DIR}/src/boring_json_iovec_writer.c
+            ${BORING_JSON_ROOT_DIR}/src/boring_json_fd_writer.c
+            ${BORING_JSON_ROOT_DIR}/src/boring_json_parallel.c)
+target_link_libraries(boring_json PUBLIC Threads::Threads)
 target_compile_features(boring_json PUBLIC c_std_11)
 
 target_include_directories(
@@ -209,3 +216,15 @@ if(CONFIG_BORING_JSON_TESTING)
   endif()
 
 endif()
+
+if(CONFIG_BORING_JSON_BENCHMARK)
+
+  # bench
+
+  set(BENCH_SRCS ${BORING_JSON_ROOT_DIR}/bench/bench_encode.c)
+
+  add_executable(boring_json_bench ${BENCH_SRCS})
+  target_compile_features(boring_json_bench PRIVATE c_std_11)
+  target_link_libraries(boring_json_bench boring_json)
+
+endif()
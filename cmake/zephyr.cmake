@@ -3,3 +3,7 @@ zephyr_library()
 zephyr_library_sources(${SOURCES})
 
 zephyr_include_directories(${BORING_JSON_ROOT_DIR}/include/)
+
+if(NOT CONFIG_THREAD_LOCAL_STORAGE)
+  zephyr_library_compile_definitions(BO_JSON_MEM_WRITER_POOL_SIZE=0)
+endif()
@@ -5,6 +5,7 @@
 #include <stddef.h>
 #include <stdbool.h>
 #include <stdint.h>
+#include <string.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -27,8 +28,27 @@ extern "C" {
 #define BO_JSON_FLAGS_NONE     (0)
 #define BO_JSON_FLAGS_NULLABLE (1 << 0)
 
+/* how a double that is infinite or NaN is encoded, an error (BO_JSON_ERROR_CONVERT) if unset */
+#define BO_JSON_FLAGS_NONFINITE_NULL   (1 << 1) // null
+#define BO_JSON_FLAGS_NONFINITE_STRING (1 << 2) // "NaN", "Infinity" or "-Infinity"
+
+/* an object bo_json_encode_cached() encodes once per cache generation */
+#define BO_JSON_FLAGS_CACHED (1 << 3)
+
+/* a double written with number.decimals decimals, "12.50" */
+#define BO_JSON_FLAGS_FIXED_DECIMALS (1 << 4)
+#define BO_JSON_FIXED_DECIMALS_MAX   (9)
+
 #define BO_JSON_NULL_BIT (1 << 0)
 
+#define BO_JSON_DECODE_FLAGS_NONE               (0)
+#define BO_JSON_DECODE_FLAGS_RESET_PRESENCE     (1 << 0)
+#define BO_JSON_DECODE_FLAGS_STOP_WHEN_COMPLETE (1 << 1)
+
+#ifndef BO_JSON_DECODE_MULTI_MAX
+#define BO_JSON_DECODE_MULTI_MAX (8)
+#endif
+
 #define BO_JSON_MEMBER_EXPR(struct_, member_) (((struct_ *)0)->member_)
 
 #define BO_JSON_CT_ASSERT(pred_, tag_) (0 * (int)sizeof(struct { int tag_[(pred_) ? 1 : -1]; }))
@@ -74,6 +94,17 @@ extern "C" {
 		 "BO_JSON_expected_member_exist_field") +                                          \
 	 BO_JSON_EXIST_OFFSET(struct_, BO_JSON_INFER_EXIST_MEMBER(member_)))
 
+/**
+ * The ready-to-emit key of an attribute, `,"name":`, skipping the leading comma for the first one.
+ * It is built from the spelling of the name, which is its JSON form when the name is a string
+ * literal without escape sequences. Any other name (escapes, a variable, a call) gets a zero
+ * key_len and is escaped by the encoder instead. Raw control characters in a literal are not
+ * detected.
+ */
+#define BO_JSON_ATTR_KEY(name_)                                                                    \
+	.key = "," #name_ ":",                                                                     \
+	.key_len = sizeof(#name_) == sizeof(name_) + 2 ? sizeof("," #name_ ":") - 1 : 0
+
 #define BO_JSON_FLAGS_OFFSET(struct_, member_)                                                     \
 	BO_JSON_MEMBER_OFFSET_TYPED(struct_, member_, unsigned char,                               \
 				    BO_JSON_expected_unsigned_char_flags_field)
@@ -81,11 +112,19 @@ extern "C" {
 #define BO_JSON_COUNT_OFFSET(struct_, member_)                                                     \
 	BO_JSON_MEMBER_OFFSET_TYPED(struct_, member_, size_t, BO_JSON_expected_size_t_count_field)
 
+#define BO_JSON_CTX_OFFSET(struct_, member_)                                                       \
+	BO_JSON_MEMBER_OFFSET_TYPED(struct_, member_, void *,                                      \
+				    BO_JSON_expected_void_pointer_ctx_field)
+
 #define BO_JSON_CSTR_CAPACITY(struct_, member_)                                                    \
 	(sizeof(BO_JSON_MEMBER_EXPR(struct_, member_)) +                                           \
 	 BO_JSON_CT_ASSERT(BO_JSON_MEMBER_IS_CHAR_ARRAY(struct_, member_),                         \
 			   BO_JSON_expected_char_array_member))
 
+#define BO_JSON_FIXED_DECIMALS(decimals_)                                                          \
+	((decimals_) + BO_JSON_CT_ASSERT((decimals_) <= BO_JSON_FIXED_DECIMALS_MAX,                \
+					  BO_JSON_expected_at_most_9_decimals))
+
 #define BO_JSON_MEMBER_ARRAY_DIM_OR_ONE(struct_, member_, elem_type_)                              \
 	((sizeof(BO_JSON_MEMBER_EXPR(struct_, member_)) / sizeof(elem_type_))                      \
 		 ? (sizeof(BO_JSON_MEMBER_EXPR(struct_, member_)) / sizeof(elem_type_))            \
@@ -114,6 +153,7 @@ enum bo_json_error_code {
 	BO_JSON_ERROR_OVERFLOW,
 	BO_JSON_ERROR_NOT_SUPPORT,
 	BO_JSON_ERROR_CONVERT,
+	BO_JSON_ERROR_IO,
 };
 
 struct bo_json_error {
@@ -124,14 +164,15 @@ struct bo_json_error {
 
 enum bo_json_value_type {
 	// <JSON type> -> <C type>
-	BO_JSON_VALUE_TYPE_NULL = 0, // null -> bool
-	BO_JSON_VALUE_TYPE_BOOL,     // bool -> bool
-	BO_JSON_VALUE_TYPE_INT,	     // number -> int
-	BO_JSON_VALUE_TYPE_INT64,    // number -> int64
-	BO_JSON_VALUE_TYPE_DOUBLE,   // number -> double
-	BO_JSON_VALUE_TYPE_CSTR,     // string -> char[]
-	BO_JSON_VALUE_TYPE_OBJECT,   // object -> struct
-	BO_JSON_VALUE_TYPE_ARRAY,    // array -> struct[]
+	BO_JSON_VALUE_TYPE_NULL = 0,  // null -> bool
+	BO_JSON_VALUE_TYPE_BOOL,      // bool -> bool
+	BO_JSON_VALUE_TYPE_INT,       // number -> int
+	BO_JSON_VALUE_TYPE_INT64,     // number -> int64
+	BO_JSON_VALUE_TYPE_DOUBLE,    // number -> double
+	BO_JSON_VALUE_TYPE_CSTR,      // string -> char[]
+	BO_JSON_VALUE_TYPE_OBJECT,    // object -> struct
+	BO_JSON_VALUE_TYPE_ARRAY,     // array -> struct[]
+	BO_JSON_VALUE_TYPE_GENERATOR, // array -> elements produced by a callback, encode only
 };
 
 #define BO_JSON_VALUE_BOOL_EXT(value_offset_, flags_offset_, flags_)                               \
@@ -174,6 +215,21 @@ enum bo_json_value_type {
 
 #define BO_JSON_VALUE_DOUBLE() BO_JSON_VALUE_DOUBLE_EXT(0, 0, BO_JSON_FLAGS_NONE)
 
+#define BO_JSON_VALUE_DOUBLE_FIXED_EXT(decimals_, value_offset_, flags_offset_, flags_)            \
+	{                                                                                          \
+		.type = BO_JSON_VALUE_TYPE_DOUBLE,                                                 \
+		.value_offset = value_offset_,                                                     \
+		.flags_offset = flags_offset_,                                                     \
+		.flags = (flags_) | BO_JSON_FLAGS_FIXED_DECIMALS,                                  \
+		.number =                                                                          \
+			{                                                                          \
+				.decimals = BO_JSON_FIXED_DECIMALS(decimals_),                     \
+			},                                                                         \
+	}
+
+#define BO_JSON_VALUE_DOUBLE_FIXED(decimals_)                                                      \
+	BO_JSON_VALUE_DOUBLE_FIXED_EXT(decimals_, 0, 0, BO_JSON_FLAGS_NONE)
+
 #define BO_JSON_VALUE_CSTR_EXT(capacity_, value_offset_, flags_offset_, flags_)                    \
 	{                                                                                          \
 		.type = BO_JSON_VALUE_TYPE_CSTR,                                                   \
@@ -220,6 +276,21 @@ enum bo_json_value_type {
 			},                                                                         \
 	}
 
+#define BO_JSON_VALUE_GENERATOR_EXT(elem_desc_, next_, value_offset_, ctx_offset_, flags_offset_,  \
+				    flags_)                                                        \
+	{                                                                                          \
+		.type = BO_JSON_VALUE_TYPE_GENERATOR,                                              \
+		.value_offset = value_offset_,                                                     \
+		.flags_offset = flags_offset_,                                                     \
+		.flags = flags_,                                                                   \
+		.generator =                                                                       \
+			{                                                                          \
+				.elem_attr_desc = elem_desc_,                                      \
+				.next = next_,                                                     \
+				.ctx_offset = ctx_offset_,                                         \
+			},                                                                         \
+	}
+
 // macros for member in struct
 
 #define BO_JSON_VALUE_STRUCT_INT(struct_, member_)                                                 \
@@ -257,14 +328,20 @@ enum bo_json_value_type {
 				capacity_, BO_JSON_COUNT_OFFSET(struct_, count_), 0,               \
 				BO_JSON_FLAGS_NONE)
 
+#define BO_JSON_VALUE_STRUCT_GENERATOR(struct_, member_, elem_desc_, next_, ctx_)                  \
+	BO_JSON_VALUE_GENERATOR_EXT(elem_desc_, next_, offsetof(struct_, member_),                 \
+				    BO_JSON_CTX_OFFSET(struct_, ctx_), 0, BO_JSON_FLAGS_NONE)
+
 #define BO_JSON_OBJECT_ATTR_BOOL_NAMED_EXIST(struct_, member_, name_, exist_)                      \
 	{.name = name_,                                                                            \
+	 BO_JSON_ATTR_KEY(name_),                                                                  \
 	 .exist_offset = BO_JSON_EXIST_OFFSET(struct_, exist_),                                    \
 	 .desc = BO_JSON_VALUE_BOOL_EXT(BO_JSON_BOOL_MEMBER_OFFSET(struct_, member_), 0,           \
 					BO_JSON_FLAGS_NONE)}
 
 #define BO_JSON_OBJECT_ATTR_BOOL_NAMED_OR_NULL_EXIST(struct_, member_, name_, exist_, flags_)      \
 	{.name = name_,                                                                            \
+	 BO_JSON_ATTR_KEY(name_),                                                                  \
 	 .exist_offset = BO_JSON_EXIST_OFFSET(struct_, exist_),                                    \
 	 .desc = BO_JSON_VALUE_BOOL_EXT(BO_JSON_BOOL_MEMBER_OFFSET(struct_, member_),              \
 					BO_JSON_FLAGS_OFFSET(struct_, flags_),                     \
@@ -273,6 +350,7 @@ enum bo_json_value_type {
 #define BO_JSON_OBJECT_ATTR_INT_NAMED_EXIST(struct_, member_, name_, exist_)                       \
 	{                                                                                          \
 		.name = name_,                                                                     \
+		BO_JSON_ATTR_KEY(name_),                                                           \
 		.exist_offset = BO_JSON_EXIST_OFFSET(struct_, exist_),                             \
 		.desc = BO_JSON_VALUE_INT_EXT(BO_JSON_INT_MEMBER_OFFSET(struct_, member_), 0,      \
 					      BO_JSON_FLAGS_NONE),                                 \
@@ -281,6 +359,7 @@ enum bo_json_value_type {
 #define BO_JSON_OBJECT_ATTR_INT_NAMED_OR_NULL_EXIST(struct_, member_, name_, exist_, flags_)       \
 	{                                                                                          \
 		.name = name_,                                                                     \
+		BO_JSON_ATTR_KEY(name_),                                                           \
 		.exist_offset = BO_JSON_EXIST_OFFSET(struct_, exist_),                             \
 		.desc = BO_JSON_VALUE_INT_EXT(BO_JSON_INT_MEMBER_OFFSET(struct_, member_),         \
 					      BO_JSON_FLAGS_OFFSET(struct_, flags_),               \
@@ -290,6 +369,7 @@ enum bo_json_value_type {
 #define BO_JSON_OBJECT_ATTR_INT64_NAMED_EXIST(struct_, member_, name_, exist_)                     \
 	{                                                                                          \
 		.name = name_,                                                                     \
+		BO_JSON_ATTR_KEY(name_),                                                           \
 		.exist_offset = BO_JSON_EXIST_OFFSET(struct_, exist_),                             \
 		.desc = BO_JSON_VALUE_INT64_EXT(BO_JSON_INT64_MEMBER_OFFSET(struct_, member_), 0,  \
 						BO_JSON_FLAGS_NONE),                               \
@@ -298,6 +378,7 @@ enum bo_json_value_type {
 #define BO_JSON_OBJECT_ATTR_INT64_NAMED_OR_NULL_EXIST(struct_, member_, name_, exist_, flags_)     \
 	{                                                                                          \
 		.name = name_,                                                                     \
+		BO_JSON_ATTR_KEY(name_),                                                           \
 		.exist_offset = BO_JSON_EXIST_OFFSET(struct_, exist_),                             \
 		.desc = BO_JSON_VALUE_INT64_EXT(BO_JSON_INT64_MEMBER_OFFSET(struct_, member_),     \
 						BO_JSON_FLAGS_OFFSET(struct_, flags_),             \
@@ -307,6 +388,7 @@ enum bo_json_value_type {
 #define BO_JSON_OBJECT_ATTR_DOUBLE_NAMED_EXIST(struct_, member_, name_, exist_)                    \
 	{                                                                                          \
 		.name = name_,                                                                     \
+		BO_JSON_ATTR_KEY(name_),                                                           \
 		.exist_offset = BO_JSON_EXIST_OFFSET(struct_, exist_),                             \
 		.desc = BO_JSON_VALUE_DOUBLE_EXT(BO_JSON_DOUBLE_MEMBER_OFFSET(struct_, member_),   \
 						 0, BO_JSON_FLAGS_NONE),                           \
@@ -315,6 +397,7 @@ enum bo_json_value_type {
 #define BO_JSON_OBJECT_ATTR_DOUBLE_NAMED_OR_NULL_EXIST(struct_, member_, name_, exist_, flags_)    \
 	{                                                                                          \
 		.name = name_,                                                                     \
+		BO_JSON_ATTR_KEY(name_),                                                           \
 		.exist_offset = BO_JSON_EXIST_OFFSET(struct_, exist_),                             \
 		.desc = BO_JSON_VALUE_DOUBLE_EXT(BO_JSON_DOUBLE_MEMBER_OFFSET(struct_, member_),   \
 						 BO_JSON_FLAGS_OFFSET(struct_, flags_),            \
@@ -324,6 +407,7 @@ enum bo_json_value_type {
 #define BO_JSON_OBJECT_ATTR_CSTR_ARRAY_NAMED_EXIST(struct_, member_, name_, exist_)                \
 	{                                                                                          \
 		.name = name_,                                                                     \
+		BO_JSON_ATTR_KEY(name_),                                                           \
 		.exist_offset = BO_JSON_EXIST_OFFSET(struct_, exist_),                             \
 		.desc = BO_JSON_VALUE_CSTR_EXT(BO_JSON_CSTR_CAPACITY(struct_, member_),            \
 					       offsetof(struct_, member_), 0, BO_JSON_FLAGS_NONE), \
@@ -333,6 +417,7 @@ enum bo_json_value_type {
 							   flags_)                                 \
 	{                                                                                          \
 		.name = name_,                                                                     \
+		BO_JSON_ATTR_KEY(name_),                                                           \
 		.exist_offset = BO_JSON_EXIST_OFFSET(struct_, exist_),                             \
 		.desc = BO_JSON_VALUE_CSTR_EXT(                                                    \
 			BO_JSON_CSTR_CAPACITY(struct_, member_), offsetof(struct_, member_),       \
@@ -342,6 +427,7 @@ enum bo_json_value_type {
 #define BO_JSON_OBJECT_ATTR_OBJECT_NAMED_EXIST(struct_, member_, obj_attrs_, name_, exist_)        \
 	{                                                                                          \
 		.name = name_,                                                                     \
+		BO_JSON_ATTR_KEY(name_),                                                           \
 		.exist_offset = BO_JSON_EXIST_OFFSET(struct_, exist_),                             \
 		.desc = BO_JSON_VALUE_OBJECT_EXT(obj_attrs_, offsetof(struct_, member_), 0,        \
 						 BO_JSON_FLAGS_NONE),                              \
@@ -351,6 +437,7 @@ enum bo_json_value_type {
 						       exist_, flags_)                             \
 	{                                                                                          \
 		.name = name_,                                                                     \
+		BO_JSON_ATTR_KEY(name_),                                                           \
 		.exist_offset = BO_JSON_EXIST_OFFSET(struct_, exist_),                             \
 		.desc = BO_JSON_VALUE_OBJECT_EXT(obj_attrs_, offsetof(struct_, member_),           \
 						 BO_JSON_FLAGS_OFFSET(struct_, flags_),            \
@@ -361,6 +448,7 @@ enum bo_json_value_type {
 						     name_, exist_)                                \
 	{                                                                                          \
 		.name = name_,                                                                     \
+		BO_JSON_ATTR_KEY(name_),                                                           \
 		.exist_offset = BO_JSON_EXIST_OFFSET(struct_, exist_),                             \
 		.desc = BO_JSON_VALUE_OBJECT_EXT(                                                  \
 			obj_attrs_,                                                                \
@@ -372,6 +460,7 @@ enum bo_json_value_type {
 							     obj_attrs_, name_, exist_, flags_)    \
 	{                                                                                          \
 		.name = name_,                                                                     \
+		BO_JSON_ATTR_KEY(name_),                                                           \
 		.exist_offset = BO_JSON_EXIST_OFFSET(struct_, exist_),                             \
 		.desc = BO_JSON_VALUE_OBJECT_EXT(                                                  \
 			obj_attrs_,                                                                \
@@ -383,6 +472,7 @@ enum bo_json_value_type {
 					      exist_, count_)                                      \
 	{                                                                                          \
 		.name = name_,                                                                     \
+		BO_JSON_ATTR_KEY(name_),                                                           \
 		.exist_offset = BO_JSON_EXIST_OFFSET(struct_, exist_),                             \
 		.desc = BO_JSON_VALUE_ARRAY_EXT(                                                   \
 			struct_, member_, elem_desc_, offsetof(struct_, member_), capacity_,       \
@@ -393,6 +483,7 @@ enum bo_json_value_type {
 						      name_, exist_, count_, flags_)               \
 	{                                                                                          \
 		.name = name_,                                                                     \
+		BO_JSON_ATTR_KEY(name_),                                                           \
 		.exist_offset = BO_JSON_EXIST_OFFSET(struct_, exist_),                             \
 		.desc = BO_JSON_VALUE_ARRAY_EXT(                                                   \
 			struct_, member_, elem_desc_, offsetof(struct_, member_), capacity_,       \
@@ -404,6 +495,7 @@ enum bo_json_value_type {
 						    capacity_, name_, exist_, count_)              \
 	{                                                                                          \
 		.name = name_,                                                                     \
+		BO_JSON_ATTR_KEY(name_),                                                           \
 		.exist_offset = BO_JSON_EXIST_OFFSET(struct_, exist_),                             \
 		.desc = BO_JSON_VALUE_ARRAY_EXT(                                                   \
 			struct_, member_, elem_desc_,                                              \
@@ -415,6 +507,7 @@ enum bo_json_value_type {
 	struct_, member_, elem_type_, elem_desc_, capacity_, name_, exist_, count_, flags_)        \
 	{                                                                                          \
 		.name = name_,                                                                     \
+		BO_JSON_ATTR_KEY(name_),                                                           \
 		.exist_offset = BO_JSON_EXIST_OFFSET(struct_, exist_),                             \
 		.desc = BO_JSON_VALUE_ARRAY_EXT(                                                   \
 			struct_, member_, elem_desc_,                                              \
@@ -425,12 +518,14 @@ enum bo_json_value_type {
 
 #define BO_JSON_OBJECT_ATTR_BOOL_NAMED(struct_, member_, name_)                                    \
 	{.name = name_,                                                                            \
+	 BO_JSON_ATTR_KEY(name_),                                                                  \
 	 .exist_offset = BO_JSON_EXIST_OFFSET_INFERRED(struct_, member_),                          \
 	 .desc = BO_JSON_VALUE_BOOL_EXT(BO_JSON_BOOL_MEMBER_OFFSET(struct_, member_), 0,           \
 					BO_JSON_FLAGS_NONE)}
 
 #define BO_JSON_OBJECT_ATTR_BOOL_NAMED_OR_NULL(struct_, member_, name_, flags_)                    \
 	{.name = name_,                                                                            \
+	 BO_JSON_ATTR_KEY(name_),                                                                  \
 	 .exist_offset = BO_JSON_EXIST_OFFSET_INFERRED(struct_, member_),                          \
 	 .desc = BO_JSON_VALUE_BOOL_EXT(BO_JSON_BOOL_MEMBER_OFFSET(struct_, member_),              \
 					BO_JSON_FLAGS_OFFSET(struct_, flags_),                     \
@@ -439,6 +534,7 @@ enum bo_json_value_type {
 #define BO_JSON_OBJECT_ATTR_INT_NAMED(struct_, member_, name_)                                     \
 	{                                                                                          \
 		.name = name_,                                                                     \
+		BO_JSON_ATTR_KEY(name_),                                                           \
 		.exist_offset = BO_JSON_EXIST_OFFSET_INFERRED(struct_, member_),                   \
 		.desc = BO_JSON_VALUE_INT_EXT(BO_JSON_INT_MEMBER_OFFSET(struct_, member_), 0,      \
 					      BO_JSON_FLAGS_NONE),                                 \
@@ -447,6 +543,7 @@ enum bo_json_value_type {
 #define BO_JSON_OBJECT_ATTR_INT_NAMED_OR_NULL(struct_, member_, name_, flags_)                     \
 	{                                                                                          \
 		.name = name_,                                                                     \
+		BO_JSON_ATTR_KEY(name_),                                                           \
 		.exist_offset = BO_JSON_EXIST_OFFSET_INFERRED(struct_, member_),                   \
 		.desc = BO_JSON_VALUE_INT_EXT(BO_JSON_INT_MEMBER_OFFSET(struct_, member_),         \
 					      BO_JSON_FLAGS_OFFSET(struct_, flags_),               \
@@ -456,6 +553,7 @@ enum bo_json_value_type {
 #define BO_JSON_OBJECT_ATTR_INT64_NAMED(struct_, member_, name_)                                   \
 	{                                                                                          \
 		.name = name_,                                                                     \
+		BO_JSON_ATTR_KEY(name_),                                                           \
 		.exist_offset = BO_JSON_EXIST_OFFSET_INFERRED(struct_, member_),                   \
 		.desc = BO_JSON_VALUE_INT64_EXT(BO_JSON_INT64_MEMBER_OFFSET(struct_, member_), 0,  \
 						BO_JSON_FLAGS_NONE),                               \
@@ -464,6 +562,7 @@ enum bo_json_value_type {
 #define BO_JSON_OBJECT_ATTR_INT64_NAMED_OR_NULL(struct_, member_, name_, flags_)                   \
 	{                                                                                          \
 		.name = name_,                                                                     \
+		BO_JSON_ATTR_KEY(name_),                                                           \
 		.exist_offset = BO_JSON_EXIST_OFFSET_INFERRED(struct_, member_),                   \
 		.desc = BO_JSON_VALUE_INT64_EXT(BO_JSON_INT64_MEMBER_OFFSET(struct_, member_),     \
 						BO_JSON_FLAGS_OFFSET(struct_, flags_),             \
@@ -473,6 +572,7 @@ enum bo_json_value_type {
 #define BO_JSON_OBJECT_ATTR_DOUBLE_NAMED(struct_, member_, name_)                                  \
 	{                                                                                          \
 		.name = name_,                                                                     \
+		BO_JSON_ATTR_KEY(name_),                                                           \
 		.exist_offset = BO_JSON_EXIST_OFFSET_INFERRED(struct_, member_),                   \
 		.desc = BO_JSON_VALUE_DOUBLE_EXT(BO_JSON_DOUBLE_MEMBER_OFFSET(struct_, member_),   \
 						 0, BO_JSON_FLAGS_NONE),                           \
@@ -481,15 +581,36 @@ enum bo_json_value_type {
 #define BO_JSON_OBJECT_ATTR_DOUBLE_NAMED_OR_NULL(struct_, member_, name_, flags_)                  \
 	{                                                                                          \
 		.name = name_,                                                                     \
+		BO_JSON_ATTR_KEY(name_),                                                           \
 		.exist_offset = BO_JSON_EXIST_OFFSET_INFERRED(struct_, member_),                   \
 		.desc = BO_JSON_VALUE_DOUBLE_EXT(BO_JSON_DOUBLE_MEMBER_OFFSET(struct_, member_),   \
 						 BO_JSON_FLAGS_OFFSET(struct_, flags_),            \
 						 BO_JSON_FLAGS_NULLABLE),                          \
 	}
 
+#define BO_JSON_OBJECT_ATTR_DOUBLE_NAMED_NONFINITE(struct_, member_, name_, nonfinite_)            \
+	{                                                                                          \
+		.name = name_,                                                                     \
+		BO_JSON_ATTR_KEY(name_),                                                           \
+		.exist_offset = BO_JSON_EXIST_OFFSET_INFERRED(struct_, member_),                   \
+		.desc = BO_JSON_VALUE_DOUBLE_EXT(BO_JSON_DOUBLE_MEMBER_OFFSET(struct_, member_),   \
+						 0, nonfinite_),                                   \
+	}
+
+#define BO_JSON_OBJECT_ATTR_DOUBLE_NAMED_FIXED(struct_, member_, name_, decimals_)                 \
+	{                                                                                          \
+		.name = name_,                                                                     \
+		BO_JSON_ATTR_KEY(name_),                                                           \
+		.exist_offset = BO_JSON_EXIST_OFFSET_INFERRED(struct_, member_),                   \
+		.desc = BO_JSON_VALUE_DOUBLE_FIXED_EXT(                                            \
+			decimals_, BO_JSON_DOUBLE_MEMBER_OFFSET(struct_, member_), 0,              \
+			BO_JSON_FLAGS_NONE),                                                       \
+	}
+
 #define BO_JSON_OBJECT_ATTR_CSTR_ARRAY_NAMED(struct_, member_, name_)                              \
 	{                                                                                          \
 		.name = name_,                                                                     \
+		BO_JSON_ATTR_KEY(name_),                                                           \
 		.exist_offset = BO_JSON_EXIST_OFFSET_INFERRED(struct_, member_),                   \
 		.desc = BO_JSON_VALUE_CSTR_EXT(BO_JSON_CSTR_CAPACITY(struct_, member_),            \
 					       offsetof(struct_, member_), 0, BO_JSON_FLAGS_NONE), \
@@ -498,6 +619,7 @@ enum bo_json_value_type {
 #define BO_JSON_OBJECT_ATTR_CSTR_ARRAY_NAMED_OR_NULL(struct_, member_, name_, flags_)              \
 	{                                                                                          \
 		.name = name_,                                                                     \
+		BO_JSON_ATTR_KEY(name_),                                                           \
 		.exist_offset = BO_JSON_EXIST_OFFSET_INFERRED(struct_, member_),                   \
 		.desc = BO_JSON_VALUE_CSTR_EXT(                                                    \
 			BO_JSON_CSTR_CAPACITY(struct_, member_), offsetof(struct_, member_),       \
@@ -507,14 +629,25 @@ enum bo_json_value_type {
 #define BO_JSON_OBJECT_ATTR_OBJECT_NAMED(struct_, member_, obj_attrs_, name_)                      \
 	{                                                                                          \
 		.name = name_,                                                                     \
+		BO_JSON_ATTR_KEY(name_),                                                           \
 		.exist_offset = BO_JSON_EXIST_OFFSET_INFERRED(struct_, member_),                   \
 		.desc = BO_JSON_VALUE_OBJECT_EXT(obj_attrs_, offsetof(struct_, member_), 0,        \
 						 BO_JSON_FLAGS_NONE),                              \
 	}
 
+#define BO_JSON_OBJECT_ATTR_OBJECT_NAMED_CACHED(struct_, member_, obj_attrs_, name_)               \
+	{                                                                                          \
+		.name = name_,                                                                     \
+		BO_JSON_ATTR_KEY(name_),                                                           \
+		.exist_offset = BO_JSON_EXIST_OFFSET_INFERRED(struct_, member_),                   \
+		.desc = BO_JSON_VALUE_OBJECT_EXT(obj_attrs_, offsetof(struct_, member_), 0,        \
+						 BO_JSON_FLAGS_CACHED),                            \
+	}
+
 #define BO_JSON_OBJECT_ATTR_OBJECT_NAMED_OR_NULL(struct_, member_, obj_attrs_, name_, flags_)      \
 	{                                                                                          \
 		.name = name_,                                                                     \
+		BO_JSON_ATTR_KEY(name_),                                                           \
 		.exist_offset = BO_JSON_EXIST_OFFSET_INFERRED(struct_, member_),                   \
 		.desc = BO_JSON_VALUE_OBJECT_EXT(obj_attrs_, offsetof(struct_, member_),           \
 						 BO_JSON_FLAGS_OFFSET(struct_, flags_),            \
@@ -524,6 +657,7 @@ enum bo_json_value_type {
 #define BO_JSON_OBJECT_ATTR_OBJECT_NAMED_TYPED(struct_, member_, member_type_, obj_attrs_, name_)  \
 	{                                                                                          \
 		.name = name_,                                                                     \
+		BO_JSON_ATTR_KEY(name_),                                                           \
 		.exist_offset = BO_JSON_EXIST_OFFSET_INFERRED(struct_, member_),                   \
 		.desc = BO_JSON_VALUE_OBJECT_EXT(                                                  \
 			obj_attrs_,                                                                \
@@ -535,6 +669,7 @@ enum bo_json_value_type {
 						       name_, flags_)                              \
 	{                                                                                          \
 		.name = name_,                                                                     \
+		BO_JSON_ATTR_KEY(name_),                                                           \
 		.exist_offset = BO_JSON_EXIST_OFFSET_INFERRED(struct_, member_),                   \
 		.desc = BO_JSON_VALUE_OBJECT_EXT(                                                  \
 			obj_attrs_,                                                                \
@@ -545,16 +680,26 @@ enum bo_json_value_type {
 #define BO_JSON_OBJECT_ATTR_ARRAY_NAMED(struct_, member_, elem_desc_, capacity_, name_, count_)    \
 	{                                                                                          \
 		.name = name_,                                                                     \
+		BO_JSON_ATTR_KEY(name_),                                                           \
 		.exist_offset = BO_JSON_EXIST_OFFSET_INFERRED(struct_, member_),                   \
 		.desc = BO_JSON_VALUE_ARRAY_EXT(                                                   \
 			struct_, member_, elem_desc_, offsetof(struct_, member_), capacity_,       \
 			BO_JSON_COUNT_OFFSET(struct_, count_), 0, BO_JSON_FLAGS_NONE),             \
 	}
 
+#define BO_JSON_OBJECT_ATTR_GENERATOR_NAMED(struct_, member_, elem_desc_, next_, ctx_, name_)      \
+	{                                                                                          \
+		.name = name_,                                                                     \
+		BO_JSON_ATTR_KEY(name_),                                                           \
+		.exist_offset = BO_JSON_EXIST_OFFSET_INFERRED(struct_, member_),                   \
+		.desc = BO_JSON_VALUE_STRUCT_GENERATOR(struct_, member_, elem_desc_, next_, ctx_), \
+	}
+
 #define BO_JSON_OBJECT_ATTR_ARRAY_NAMED_OR_NULL(struct_, member_, elem_desc_, capacity_, name_,    \
 						count_, flags_)                                    \
 	{                                                                                          \
 		.name = name_,                                                                     \
+		BO_JSON_ATTR_KEY(name_),                                                           \
 		.exist_offset = BO_JSON_EXIST_OFFSET_INFERRED(struct_, member_),                   \
 		.desc = BO_JSON_VALUE_ARRAY_EXT(                                                   \
 			struct_, member_, elem_desc_, offsetof(struct_, member_), capacity_,       \
@@ -566,6 +711,7 @@ enum bo_json_value_type {
 					      name_, count_)                                       \
 	{                                                                                          \
 		.name = name_,                                                                     \
+		BO_JSON_ATTR_KEY(name_),                                                           \
 		.exist_offset = BO_JSON_EXIST_OFFSET_INFERRED(struct_, member_),                   \
 		.desc = BO_JSON_VALUE_ARRAY_EXT(                                                   \
 			struct_, member_, elem_desc_,                                              \
@@ -577,6 +723,7 @@ enum bo_json_value_type {
 						      capacity_, name_, count_, flags_)            \
 	{                                                                                          \
 		.name = name_,                                                                     \
+		BO_JSON_ATTR_KEY(name_),                                                           \
 		.exist_offset = BO_JSON_EXIST_OFFSET_INFERRED(struct_, member_),                   \
 		.desc = BO_JSON_VALUE_ARRAY_EXT(                                                   \
 			struct_, member_, elem_desc_,                                              \
@@ -677,6 +824,12 @@ enum bo_json_value_type {
 #define BO_JSON_OBJECT_ATTR_DOUBLE_OR_NULL(struct_, member_, flags_)                               \
 	BO_JSON_OBJECT_ATTR_DOUBLE_NAMED_OR_NULL(struct_, member_, #member_, flags_)
 
+#define BO_JSON_OBJECT_ATTR_DOUBLE_NONFINITE(struct_, member_, nonfinite_)                         \
+	BO_JSON_OBJECT_ATTR_DOUBLE_NAMED_NONFINITE(struct_, member_, #member_, nonfinite_)
+
+#define BO_JSON_OBJECT_ATTR_DOUBLE_FIXED(struct_, member_, decimals_)                              \
+	BO_JSON_OBJECT_ATTR_DOUBLE_NAMED_FIXED(struct_, member_, #member_, decimals_)
+
 #define BO_JSON_OBJECT_ATTR_CSTR_ARRAY(struct_, member_)                                           \
 	BO_JSON_OBJECT_ATTR_CSTR_ARRAY_NAMED(struct_, member_, #member_)
 
@@ -686,6 +839,9 @@ enum bo_json_value_type {
 #define BO_JSON_OBJECT_ATTR_OBJECT(struct_, member_, obj_attrs_)                                   \
 	BO_JSON_OBJECT_ATTR_OBJECT_NAMED(struct_, member_, obj_attrs_, #member_)
 
+#define BO_JSON_OBJECT_ATTR_OBJECT_CACHED(struct_, member_, obj_attrs_)                            \
+	BO_JSON_OBJECT_ATTR_OBJECT_NAMED_CACHED(struct_, member_, obj_attrs_, #member_)
+
 #define BO_JSON_OBJECT_ATTR_OBJECT_TYPED(struct_, member_, member_type_, obj_attrs_)               \
 	BO_JSON_OBJECT_ATTR_OBJECT_NAMED_TYPED(struct_, member_, member_type_, obj_attrs_, #member_)
 
@@ -700,6 +856,9 @@ enum bo_json_value_type {
 #define BO_JSON_OBJECT_ATTR_ARRAY(struct_, member_, elem_desc_, capacity_, count_)                 \
 	BO_JSON_OBJECT_ATTR_ARRAY_NAMED(struct_, member_, elem_desc_, capacity_, #member_, count_)
 
+#define BO_JSON_OBJECT_ATTR_GENERATOR(struct_, member_, elem_desc_, next_, ctx_)                   \
+	BO_JSON_OBJECT_ATTR_GENERATOR_NAMED(struct_, member_, elem_desc_, next_, ctx_, #member_)
+
 #define BO_JSON_OBJECT_ATTR_ARRAY_TYPED(struct_, member_, elem_type_, elem_desc_, capacity_,       \
 					count_)                                                    \
 	BO_JSON_OBJECT_ATTR_ARRAY_NAMED_TYPED(struct_, member_, elem_type_, elem_desc_, capacity_, \
@@ -729,6 +888,25 @@ struct bo_json_value_desc {
 		struct {
 			size_t capacity;
 		} string;
+		/**
+		 * With BO_JSON_FLAGS_FIXED_DECIMALS, a double is rounded to this many decimals;
+		 * values too large for it are written like any other double.
+		 */
+		struct {
+			unsigned int decimals;
+		} number;
+		/**
+		 * The elements are produced one at a time into the storage at value_offset,
+		 * by next(ctx, elem) with the `void *` at ctx_offset. next returns 1 when it
+		 * produced an element, 0 after the last one and a negative errno on failure.
+		 * Only bo_json_encode() and its variants support it, not the size
+		 * computations nor the step encoder.
+		 */
+		struct {
+			const struct bo_json_value_desc *elem_attr_desc;
+			int (*next)(void *ctx, void *elem);
+			size_t ctx_offset;
+		} generator;
 	};
 	size_t value_offset;
 	size_t flags_offset;
@@ -739,9 +917,71 @@ struct bo_json_value_desc {
 struct bo_json_obj_attr_desc {
 	struct bo_json_value_desc desc;
 	const char *name;
+	/**
+	 * `,"name":` as written by the encoder, used when key_len is not 0, otherwise the key is
+	 * built from name
+	 */
+	const char *key;
+	size_t key_len;
 	size_t exist_offset;
 };
 
+#define BO_JSON_PROJECTION_BITS      (64)
+#define BO_JSON_PROJECTION_BIT(index_) ((uint64_t)1 << (index_))
+#define BO_JSON_PROJECTION_ALL         (~(uint64_t)0)
+
+/**
+ * @brief Runtime selection of the attributes of an object descriptor
+ *
+ * Bit `i` of `mask` selects `object.attr_descs[i]`; attributes past the first
+ * `BO_JSON_PROJECTION_BITS` are always selected. `attrs` is either NULL or holds one entry per
+ * attribute with the projection of that attribute's nested object (or of the object elements of
+ * its array); a NULL entry selects the whole nested value. A projection applied to an array
+ * applies to each of its elements.
+ */
+struct bo_json_projection {
+	uint64_t mask;
+	const struct bo_json_projection *const *attrs;
+};
+
+static inline bool bo_json_projection_selects(const struct bo_json_projection *proj, size_t index)
+{
+	return proj == NULL || index >= BO_JSON_PROJECTION_BITS ||
+	       (proj->mask & BO_JSON_PROJECTION_BIT(index)) != 0;
+}
+
+static inline const struct bo_json_projection *
+bo_json_projection_attr(const struct bo_json_projection *proj, size_t index)
+{
+	return (proj != NULL && proj->attrs != NULL) ? proj->attrs[index] : NULL;
+}
+
+/**
+ * @brief Attributes of an object descriptor modified by bo_json_decode_merge()
+ *
+ * Bit `i` of `mask` is set when `object.attr_descs[i]` was added, changed or switched between
+ * null and a value; attributes past the first `BO_JSON_PROJECTION_BITS` are not tracked. `attrs`
+ * is either NULL or holds one entry per attribute receiving the changes inside that attribute's
+ * nested object (accumulated over all elements for an array of objects); NULL entries are only
+ * reported through the attribute's own bit.
+ */
+struct bo_json_changes {
+	uint64_t mask;
+	struct bo_json_changes *const *attrs;
+};
+
+static inline bool bo_json_changes_test(const struct bo_json_changes *changes, size_t index)
+{
+	return index < BO_JSON_PROJECTION_BITS &&
+	       (changes->mask & BO_JSON_PROJECTION_BIT(index)) != 0;
+}
+
+static inline struct bo_json_changes *bo_json_changes_attr(const struct bo_json_changes *changes,
+							   size_t index)
+{
+	return (changes != NULL && changes->attrs != NULL) ? changes->attrs[index] : NULL;
+}
+
 /* primitives types of boring json */
 extern struct bo_json_value_desc bo_json_null_desc;
 extern struct bo_json_value_desc bo_json_bool_desc;
@@ -767,16 +1007,212 @@ extern struct bo_json_value_desc bo_json_double_desc;
 struct bo_json_error bo_json_decode(const char *in, const size_t in_len,
 				    const struct bo_json_value_desc *desc, void *out);
 
+/**
+ * @brief Decode a JSON string like bo_json_decode() with decode flags and a projection.
+ *
+ * With `BO_JSON_DECODE_FLAGS_RESET_PRESENCE`, every decoded object first clears the exist field
+ * and the null bit of each of its attributes, so an output structure can be reused across
+ * decodes without zeroing it first. Only the presence bookkeeping is reset: the storage of an
+ * absent attribute keeps its previous contents and must be ignored based on its exist field.
+ *
+ * Attributes not selected by `proj` are skipped like unknown keys: their values are still
+ * validated but neither converted nor copied, and their exist fields are left untouched.
+ *
+ * With `BO_JSON_DECODE_FLAGS_STOP_WHEN_COMPLETE`, decoding of the outermost object stops as soon
+ * as every attribute selected by `proj` (every attribute when `proj` is NULL) has been decoded,
+ * and `pos` of the returned error points right after the last decoded value. The remainder of
+ * the document is NOT validated, so a malformed tail is not reported in that case. The flag has
+ * no effect on objects with more than `BO_JSON_PROJECTION_BITS` attributes.
+ *
+ * @param[in] in The JSON string to decode.
+ * @param[in] in_len The length of the input JSON string.
+ * @param[in] desc A pointer to a `bo_json_value_desc` struct that describes the expected structure
+ * of the JSON data.
+ * @param[out] out A pointer to the output data object where the decoded JSON data will be stored.
+ * @param[in] flags Bitwise OR of `BO_JSON_DECODE_FLAGS_*`.
+ * @param[in] proj Attributes to decode, NULL to decode every attribute.
+ * @return A `struct bo_json_error` object indicating the success or failure of the decoding
+ * process. If successful, the error code will be `BO_JSON_ERROR_NONE`.
+ */
+struct bo_json_error bo_json_decode_ex(const char *in, const size_t in_len,
+				       const struct bo_json_value_desc *desc, void *out,
+				       unsigned int flags, const struct bo_json_projection *proj);
+
+/**
+ * @brief Merge a partial JSON document into an existing C data object.
+ *
+ * Attributes present in the document overwrite the corresponding fields of `out`; absent
+ * attributes are left untouched. Every decoded value is compared with the value it replaces and
+ * the attributes that actually changed are reported in `changes`, so no separate snapshot and
+ * compare pass is needed. Arrays are replaced as a whole: object elements only keep the attributes
+ * present in the document, and the attributes they lose are reported as changes too.
+ *
+ * @param[in] in The JSON string to decode.
+ * @param[in] in_len The length of the input JSON string.
+ * @param[in] desc A pointer to a `bo_json_value_desc` struct that describes the expected structure
+ * of the JSON data.
+ * @param[in,out] out A pointer to the data object to merge the JSON data into.
+ * @param[out] changes Tree of changed attributes, cleared before decoding. May be NULL.
+ * @return A `struct bo_json_error` object indicating the success or failure of the decoding
+ * process. On failure `out` may already hold part of the update.
+ */
+struct bo_json_error bo_json_decode_merge(const char *in, const size_t in_len,
+					  const struct bo_json_value_desc *desc, void *out,
+					  struct bo_json_changes *changes);
+
+/**
+ * @brief One destination of bo_json_decode_multi(), a descriptor and the data it describes
+ */
+struct bo_json_decode_target {
+	const struct bo_json_value_desc *desc;
+	void *out;
+};
+
+/**
+ * @brief Decode one JSON document into several data objects in a single pass.
+ *
+ * The document is lexed once; every value is written to each target whose descriptor contains
+ * it, so the cost of lexing does not grow with the number of targets. Targets walked together
+ * must agree on which values are objects and arrays.
+ *
+ * @param[in] in The JSON string to decode.
+ * @param[in] in_len The length of the input JSON string.
+ * @param[in] targets The descriptors and data objects to decode into. A target with a NULL desc
+ * is ignored.
+ * @param[in] n_targets The number of targets, at most `BO_JSON_DECODE_MULTI_MAX`.
+ * @return A `struct bo_json_error` object indicating the success or failure of the decoding
+ * process. BO_JSON_ERROR_NOT_SUPPORT if there are too many targets.
+ */
+struct bo_json_error bo_json_decode_multi(const char *in, const size_t in_len,
+					  const struct bo_json_decode_target *targets,
+					  size_t n_targets);
+
+/**
+ * @brief Output of the encoder
+ *
+ * `write` receives everything the encoder produces. The other members are optional and only used
+ * once bo_json_writer_init() has pointed `self` at the writer, so a writer which merely sets
+ * `write` never has them read. Initialize the writer first, then set the members it implements.
+ *
+ * A writer backed by memory may expose a window [`pos`, `end`) which bo_json_writer_write() fills
+ * inline, calling `write` only once a piece does not fit. Writers without a window keep both NULL.
+ *
+ * Writers may also implement `reserve` and `commit` so the encoder formats numbers straight into
+ * their memory instead of a temporary buffer: `reserve` returns room for at least `len` bytes, or
+ * NULL to fall back to `write`, and `commit` then accounts for the `len` bytes actually used. A
+ * `reserve` which makes room in the window and returns `pos` needs no `commit`.
+ *
+ * `write_ref`, when set, receives the pieces which stay valid until the output is flushed (string
+ * bodies of the encoded value, keys and literals of the descriptors), so the writer can keep a
+ * reference instead of a copy. Without it they go through `write`, as do all the pieces of
+ * generator elements, whose storage is overwritten by the next element.
+ */
 struct bo_json_writer {
 	struct bo_json_error (*write)(struct bo_json_writer *writer, const void *data, size_t len);
+	const struct bo_json_writer *self;
+	struct bo_json_error (*write_ref)(struct bo_json_writer *writer, const void *data,
+					  size_t len);
+	char *(*reserve)(struct bo_json_writer *writer, size_t len);
+	void (*commit)(struct bo_json_writer *writer, size_t len);
+	char *pos;
+	char *end;
 };
 
+/**
+ * @brief Initialize the common part of a writer, with none of the optional operations
+ *
+ * A copy of an initialized writer does not point `self` at itself and only uses `write`.
+ */
+static inline void bo_json_writer_init(struct bo_json_writer *writer,
+				       struct bo_json_error (*write)(struct bo_json_writer *writer,
+								     const void *data, size_t len))
+{
+	writer->write = write;
+	writer->self = writer;
+	writer->write_ref = NULL;
+	writer->reserve = NULL;
+	writer->commit = NULL;
+	writer->pos = NULL;
+	writer->end = NULL;
+}
+
+/**
+ * @brief Whether the optional members of a writer were set up by bo_json_writer_init()
+ */
+static inline bool bo_json_writer_is_init(const struct bo_json_writer *writer)
+{
+	return writer->self == writer;
+}
+
+/**
+ * @brief Whether a writer exposes a window, see `pos` and `end`
+ */
+static inline bool bo_json_writer_has_window(const struct bo_json_writer *writer)
+{
+	return bo_json_writer_is_init(writer) && writer->pos != NULL;
+}
+
 static inline struct bo_json_error bo_json_writer_write(struct bo_json_writer *writer,
 							const void *data, size_t len)
 {
+	if (bo_json_writer_has_window(writer) && (size_t)(writer->end - writer->pos) >= len) {
+		memcpy(writer->pos, data, len);
+		writer->pos += len;
+		return BO_JSON_OK();
+	}
+
 	return writer->write(writer, data, len);
 }
 
+/**
+ * @brief Write a piece which stays valid until the output is flushed, see `write_ref`
+ */
+static inline struct bo_json_error bo_json_writer_write_ref(struct bo_json_writer *writer,
+							    const void *data, size_t len)
+{
+	if (bo_json_writer_is_init(writer) && writer->write_ref != NULL) {
+		return writer->write_ref(writer, data, len);
+	}
+
+	return bo_json_writer_write(writer, data, len);
+}
+
+/**
+ * @brief Get room for at least len bytes in the writer's memory
+ *
+ * @return Where to write, to be followed by bo_json_writer_commit(), or NULL if the writer cannot
+ * provide it and bo_json_writer_write() must be used instead
+ */
+static inline char *bo_json_writer_reserve(struct bo_json_writer *writer, size_t len)
+{
+	if (!bo_json_writer_is_init(writer)) {
+		return NULL;
+	}
+
+	if (writer->pos != NULL && (size_t)(writer->end - writer->pos) >= len) {
+		return writer->pos;
+	}
+
+	return (writer->reserve != NULL) ? writer->reserve(writer, len) : NULL;
+}
+
+/**
+ * @brief Account for the bytes written at the memory returned by bo_json_writer_reserve()
+ *
+ * @param[in] writer   The writer
+ * @param[in] reserved What bo_json_writer_reserve() returned
+ * @param[in] len      The number of bytes written, at most what was reserved
+ */
+static inline void bo_json_writer_commit(struct bo_json_writer *writer, const char *reserved,
+					 size_t len)
+{
+	if (reserved == writer->pos) {
+		writer->pos += len;
+	} else {
+		writer->commit(writer, len);
+	}
+}
+
 /**
  * Encodes a JSON value into a JSON string and writes it to the provided JSON writer.
  *
@@ -791,6 +1227,332 @@ static inline struct bo_json_error bo_json_writer_write(struct bo_json_writer *w
 struct bo_json_error bo_json_encode(const void *in, const struct bo_json_value_desc *in_desc,
 				    struct bo_json_writer *writer);
 
+/**
+ * @brief Encode a value like bo_json_encode(), writing only the attributes selected by a
+ * projection
+ *
+ * Attributes not selected by `proj` are skipped as if they were absent, so one descriptor can
+ * serve several views of the same data. The projection of an array applies to each element.
+ *
+ * @param[in] in      The value to encode
+ * @param[in] in_desc The description of the value
+ * @param[in] proj    Attributes to encode, NULL to encode every present attribute
+ * @param     writer  The JSON writer
+ * @return A struct bo_json_error indicating any errors that occurred during encoding
+ */
+struct bo_json_error bo_json_encode_ex(const void *in, const struct bo_json_value_desc *in_desc,
+				       const struct bo_json_projection *proj,
+				       struct bo_json_writer *writer);
+
+#ifndef BO_JSON_NDJSON_BLOCK_SIZE
+#define BO_JSON_NDJSON_BLOCK_SIZE (4096)
+#endif
+
+/**
+ * @brief Encode the elements of a C array as newline-delimited JSON, one line per element
+ *
+ * When the writer has no inline window, the lines are collected in a block of
+ * BO_JSON_NDJSON_BLOCK_SIZE bytes on the stack and the writer receives whole blocks instead of
+ * a call per token.
+ *
+ * On error the writer has received every line before the failing element, followed by the part
+ * of that element encoded before the error, wherever the block boundaries fell.
+ *
+ * @param[in] array     The first element
+ * @param[in] elem_size The size of an element
+ * @param[in] count     The number of elements
+ * @param[in] elem_desc The description of an element
+ * @param     writer    The JSON writer
+ * @return BO_JSON_OK() on success, the error bo_json_encode() returns for the first element
+ * that fails otherwise
+ */
+struct bo_json_error bo_json_encode_ndjson(const void *array, size_t elem_size, size_t count,
+					   const struct bo_json_value_desc *elem_desc,
+					   struct bo_json_writer *writer);
+
+/**
+ * @brief Encode only what changed in an object since a previous snapshot of it
+ *
+ * The output is a JSON merge patch (RFC 7386) turning the snapshot into the current value:
+ * attributes which changed are written, attributes which disappeared are written as `null`,
+ * nested objects are compared attribute by attribute and arrays are written whole if any of
+ * their elements changed. Doubles are compared bit for bit. An unchanged object is written as
+ * `{}`, a value which is not an object is written whole.
+ *
+ * @param[in] in      The current value
+ * @param[in] prev    The snapshot, described by the same descriptor
+ * @param[in] in_desc The description of both values
+ * @param     writer  The JSON writer
+ * @return A struct bo_json_error indicating any errors that occurred during encoding
+ */
+struct bo_json_error bo_json_encode_delta(const void *in, const void *prev,
+					  const struct bo_json_value_desc *in_desc,
+					  struct bo_json_writer *writer);
+
+/**
+ * @brief The encoded bytes of one object, found by its address and descriptor
+ *
+ * The bytes are only valid in the generation they were encoded in. An entry keeps its `cap` bytes
+ * of cache memory across generations and is encoded again into them.
+ */
+struct bo_json_cache_entry {
+	const void *in;
+	const struct bo_json_value_desc *desc;
+	unsigned int generation;
+	// the object did not fit in the cache memory in this generation
+	bool too_large;
+	size_t offset;
+	size_t cap;
+	size_t len;
+};
+
+/**
+ * @brief Encoded objects kept in caller memory, see bo_json_encode_cached()
+ *
+ * The entries and the bytes are both bounded by the caller. Once the entries are used up, objects
+ * without one are encoded every time; an object that does not fit in its memory is encoded
+ * every time until the next generation.
+ */
+struct bo_json_cache {
+	struct bo_json_cache_entry *entries;
+	size_t n_entries;
+	char *buf;
+	size_t cap;
+
+	// bumped by bo_json_cache_bump()
+	unsigned int generation;
+	size_t n_used;
+	size_t used;
+};
+
+/**
+ * @brief Initialize an empty cache
+ *
+ * @param[out] cache     The cache
+ * @param[in]  entries   The entries, one per cached object
+ * @param[in]  n_entries The number of entries
+ * @param[in]  buf       The memory holding the encoded objects
+ * @param[in]  cap       The capacity of the memory
+ */
+void bo_json_cache_init(struct bo_json_cache *cache, struct bo_json_cache_entry *entries,
+			size_t n_entries, char *buf, size_t cap);
+
+/**
+ * @brief Start a new generation, so that every cached object is encoded again when next met
+ *
+ * Must be called whenever a cached object may have changed. The entries keep their memory, an
+ * object that is no longer encoded keeps its entry until bo_json_cache_init() is called again.
+ *
+ * @param[in] cache The cache
+ */
+void bo_json_cache_bump(struct bo_json_cache *cache);
+
+/**
+ * @brief Encode a value like bo_json_encode(), writing objects flagged BO_JSON_FLAGS_CACHED from
+ * a cache
+ *
+ * A flagged object is encoded the first time it is met in a generation, found again by its
+ * address, descriptor and generation, and written verbatim from then on. Flagged objects nested
+ * in a flagged object are part of its entry.
+ *
+ * @param[in] in      The value to encode
+ * @param[in] in_desc The description of the value
+ * @param     cache   The cache
+ * @param     writer  The JSON writer
+ * @return A struct bo_json_error indicating any errors that occurred during encoding
+ */
+struct bo_json_error bo_json_encode_cached(const void *in, const struct bo_json_value_desc *in_desc,
+					   struct bo_json_cache *cache,
+					   struct bo_json_writer *writer);
+
+/**
+ * @brief A value of a template, and the literal text written before it
+ */
+struct bo_json_template_hole {
+	const struct bo_json_value_desc *desc;
+	// where the value described by desc is read, relative to the encoded value
+	size_t offset;
+	size_t literal_offset;
+	size_t literal_len;
+};
+
+/**
+ * @brief The output of a descriptor as literal text with holes for the values, see
+ * bo_json_template_build()
+ */
+struct bo_json_template {
+	struct bo_json_template_hole *holes;
+	size_t n_holes;
+	const char *literals;
+	// what follows the last hole
+	size_t tail_offset;
+	size_t tail_len;
+};
+
+/**
+ * @brief Precompute the literal text of a descriptor whose attributes are always present
+ *
+ * Braces and keys of objects, nested objects included, become literal text; every other value
+ * (numbers, strings, booleans and arrays) becomes a hole. The template is kept in caller memory
+ * and stays valid as long as it and the descriptor do.
+ *
+ * @param[out] tmpl         The template
+ * @param[in]  desc         The description of the values to encode
+ * @param[out] holes        The holes, one per value which is not an object
+ * @param[in]  holes_cap    The number of holes
+ * @param[out] literals     The memory holding the literal text
+ * @param[in]  literals_cap The capacity of the memory
+ * @return BO_JSON_OK() on success, BO_JSON_ERROR_INSUFFICIENT_SPACE if the holes or the literal
+ * text do not fit
+ */
+struct bo_json_error bo_json_template_build(struct bo_json_template *tmpl,
+					    const struct bo_json_value_desc *desc,
+					    struct bo_json_template_hole *holes, size_t holes_cap,
+					    char *literals, size_t literals_cap);
+
+/**
+ * @brief Encode a value through a template
+ *
+ * Every attribute is written, presence flags are not read. The output is the one of
+ * bo_json_encode() with every attribute present.
+ *
+ * @param[in] tmpl   The template built from the description of the value
+ * @param[in] in     The value to encode
+ * @param     writer The JSON writer
+ * @return A struct bo_json_error indicating any errors that occurred during encoding
+ */
+struct bo_json_error bo_json_template_encode(const struct bo_json_template *tmpl, const void *in,
+					     struct bo_json_writer *writer);
+
+/**
+ * @brief Compute the exact length bo_json_encode() writes for a value, without formatting it
+ *
+ * Lets the caller reserve a single buffer of the right size before encoding.
+ *
+ * @param[in]  in      The value to encode
+ * @param[in]  in_desc The description of the value
+ * @param[out] size    The length of the encoded JSON text, not counting any terminator
+ * @return BO_JSON_OK() on success, the error bo_json_encode() would return otherwise
+ */
+struct bo_json_error bo_json_encoded_size(const void *in, const struct bo_json_value_desc *in_desc,
+					  size_t *size);
+
+/**
+ * @brief Compute the largest length bo_json_encode() can write for any value of a descriptor
+ *
+ * Every attribute is counted as present, every array as full, every string as filling its
+ * capacity with characters escaped as \u00XX and every number with its longest representation.
+ * A buffer of this size never fails with BO_JSON_ERROR_INSUFFICIENT_SPACE.
+ *
+ * @param[in]  in_desc The description of the value
+ * @param[out] size    The largest length of the encoded JSON text, not counting any terminator
+ * @return BO_JSON_OK() on success, BO_JSON_ERROR_NOT_SUPPORT if the descriptor cannot be encoded
+ */
+struct bo_json_error bo_json_max_encoded_size(const struct bo_json_value_desc *in_desc,
+					      size_t *size);
+
+/*
+ * The same bounds as constant expressions, to size static buffers, e.g.
+ *
+ *   static char frame[BO_JSON_MAX_SIZE_OBJECT(
+ *           BO_JSON_MAX_SIZE_ATTR("id", BO_JSON_MAX_SIZE_INT) +
+ *           BO_JSON_MAX_SIZE_ATTR("name", BO_JSON_MAX_SIZE_CSTR(32)))];
+ */
+
+#define BO_JSON_MAX_SIZE_BOOL (5)
+// "-2147483648" with a 32 bits int
+#define BO_JSON_MAX_SIZE_INT (sizeof(int) <= 2 ? 6 : sizeof(int) <= 4 ? 11 : 20)
+// "-9223372036854775808"
+#define BO_JSON_MAX_SIZE_INT64 (20)
+// "-0.0000012345678901234567", longer than any non-finite policy output
+#define BO_JSON_MAX_SIZE_DOUBLE (25)
+
+// every byte escaped as \u00XX, between quotes
+#define BO_JSON_MAX_SIZE_CSTR(capacity_) (2 + (6 * (size_t)(capacity_)))
+
+// elem_max_ for each element, the commas between them and the brackets
+#define BO_JSON_MAX_SIZE_ARRAY(capacity_, elem_max_)                                               \
+	((capacity_) > 0 ? 1 + ((size_t)(capacity_) * ((size_t)(elem_max_) + 1)) : 2)
+
+/**
+ * An attribute of BO_JSON_MAX_SIZE_OBJECT(), `,"name":` then the value. The name must be a string
+ * literal which does not need escaping, like the names of the attribute macros.
+ */
+#define BO_JSON_MAX_SIZE_ATTR(name_, value_max_)                                                   \
+	(sizeof(",\"" name_ "\":") - 1 + (size_t)(value_max_))
+
+// attrs_max_ is the sum of BO_JSON_MAX_SIZE_ATTR() of every attribute, the first one has no comma
+#define BO_JSON_MAX_SIZE_OBJECT(attrs_max_) ((attrs_max_) > 0 ? 1 + (size_t)(attrs_max_) : 2)
+
+#ifndef BO_JSON_ENCODER_MAX_DEPTH
+#define BO_JSON_ENCODER_MAX_DEPTH (16)
+#endif
+
+/**
+ * @brief An object or array the step encoder is inside of
+ */
+struct bo_json_encoder_frame {
+	const struct bo_json_value_desc *desc;
+	// the object or the first element of the array
+	const char *base;
+	// the next attribute or element
+	size_t index;
+	// attributes written so far, elements of the array
+	size_t count;
+	// the key or comma of index is written, its value comes next
+	bool value_next;
+};
+
+/**
+ * @brief Encoder producing the output in chunks of any size, see bo_json_encoder_step()
+ *
+ * Keeps the position in the value as an explicit stack instead of the call stack, so that
+ * encoding can stop when the chunk is full and resume from the exact same byte.
+ */
+struct bo_json_encoder {
+	const void *in;
+	const struct bo_json_value_desc *in_desc;
+	struct bo_json_encoder_frame stack[BO_JSON_ENCODER_MAX_DEPTH];
+	size_t depth;
+	bool started;
+
+	// what is left of the piece being written
+	const char *piece;
+	size_t piece_len;
+
+	// what is left of the string being written, and what closes it
+	const char *str;
+	const char *str_end;
+	const char *str_close;
+
+	// numbers and escape sequences are formatted here
+	char scratch[32];
+};
+
+/**
+ * @brief Prepare the step encoding of a value
+ *
+ * @param[out] encoder The encoder
+ * @param[in]  in      The value to encode, which must not change until the encoding is done
+ * @param[in]  in_desc The description of the value
+ */
+void bo_json_encoder_init(struct bo_json_encoder *encoder, const void *in,
+			  const struct bo_json_value_desc *in_desc);
+
+/**
+ * @brief Write the next chunk of the encoded value
+ *
+ * @param[in]  encoder The encoder
+ * @param[out] buf     The chunk
+ * @param[in]  cap     The capacity of the chunk, any size
+ * @param[out] written The number of bytes written to the chunk
+ * @return BO_JSON_ERROR_PARTIAL while more output follows, BO_JSON_OK() once the value is
+ * complete, BO_JSON_ERROR_OVERFLOW when nesting exceeds BO_JSON_ENCODER_MAX_DEPTH, or the error
+ * bo_json_encode() would return
+ */
+struct bo_json_error bo_json_encoder_step(struct bo_json_encoder *encoder, char *buf, size_t cap,
+					  size_t *written);
+
 int bo_json_error_to_errno(const struct bo_json_error *err);
 
 #ifdef __cplusplus
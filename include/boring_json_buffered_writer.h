@@ -0,0 +1,50 @@
+#ifndef BORING_JSON_BUFFERED_WRITER_H_
+#define BORING_JSON_BUFFERED_WRITER_H_
+
+#include "boring_json.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Writer collecting the output in a fixed buffer before passing it on to another writer
+ *
+ * The buffer is exposed as the inline window of `ctx`, so the encoder fills it without calling
+ * through `write`; the wrapped writer only sees full buffers, and whatever is left when
+ * bo_json_buffered_writer_flush() is called.
+ */
+struct bo_json_buffered_writer {
+	struct bo_json_writer ctx;
+	struct bo_json_writer *next;
+
+	char *buf;
+	size_t cap;
+};
+
+/**
+ * @brief Initialize a buffered writer
+ *
+ * @param[out] writer The buffered writer
+ * @param[in]  next   The writer receiving the buffered output
+ * @param[in]  buf    The buffer
+ * @param[in]  cap    The capacity of the buffer
+ */
+void bo_json_buffered_writer_init(struct bo_json_buffered_writer *writer,
+				  struct bo_json_writer *next, void *buf, size_t cap);
+
+/**
+ * @brief Pass the buffered output on to the wrapped writer
+ *
+ * Must be called once the encoding is done, the buffer can then be reused.
+ *
+ * @param[in] writer The buffered writer
+ * @return The error of the wrapped writer, if any
+ */
+struct bo_json_error bo_json_buffered_writer_flush(struct bo_json_buffered_writer *writer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BORING_JSON_BUFFERED_WRITER_H_ */
@@ -0,0 +1,79 @@
+#ifndef BORING_JSON_FD_WRITER_H_
+#define BORING_JSON_FD_WRITER_H_
+
+#include <pthread.h>
+
+#include "boring_json.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef BO_JSON_FD_WRITER_MAX_BUFS
+#define BO_JSON_FD_WRITER_MAX_BUFS (8)
+#endif
+
+/**
+ * @brief Writer sending the output to a file descriptor from a background thread
+ *
+ * The memory given at init is split in `n_bufs` buffers. The encoder fills one of them through
+ * the inline window of `ctx` while the flusher thread writes the full ones, so encoding overlaps
+ * with the I/O and memory stays bounded. The encoder only waits when every buffer is full.
+ */
+struct bo_json_fd_writer {
+	struct bo_json_writer ctx;
+	int fd;
+
+	char *buf;
+	size_t buf_size;
+	size_t n_bufs;
+	size_t lens[BO_JSON_FD_WRITER_MAX_BUFS];
+
+	// the buffer being filled, the next one to write and how many are waiting, under lock
+	size_t fill;
+	size_t head;
+	size_t n_full;
+	bool stop;
+	// first error of the flusher, reported by every later call
+	enum bo_json_error_code err;
+
+	pthread_t thread;
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+};
+
+/**
+ * @brief Initialize a file descriptor writer and start its flusher thread
+ *
+ * @param[out] writer   The fd writer
+ * @param[in]  fd       The file descriptor the output is written to, a file or a pipe
+ * @param[in]  buf      The memory of the buffers, n_bufs * buf_size bytes
+ * @param[in]  buf_size The size of one buffer
+ * @param[in]  n_bufs   The number of buffers, from 1 to BO_JSON_FD_WRITER_MAX_BUFS
+ * @return BO_JSON_ERROR_NOT_SUPPORT for a wrong number of buffers, BO_JSON_ERROR_INSUFFICIENT_SPACE
+ * if the thread cannot be started
+ */
+struct bo_json_error bo_json_fd_writer_init(struct bo_json_fd_writer *writer, int fd, void *buf,
+					    size_t buf_size, size_t n_bufs);
+
+/**
+ * @brief Hand the buffer being filled to the flusher and wait until everything is written
+ *
+ * @param[in] writer The fd writer
+ * @return BO_JSON_ERROR_IO if a write failed
+ */
+struct bo_json_error bo_json_fd_writer_flush(struct bo_json_fd_writer *writer);
+
+/**
+ * @brief Flush, then stop the flusher thread; the file descriptor is left open
+ *
+ * @param[in] writer The fd writer
+ * @return The error of the flush
+ */
+struct bo_json_error bo_json_fd_writer_cleanup(struct bo_json_fd_writer *writer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BORING_JSON_FD_WRITER_H_ */
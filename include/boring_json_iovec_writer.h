@@ -0,0 +1,66 @@
+#ifndef BORING_JSON_IOVEC_WRITER_H_
+#define BORING_JSON_IOVEC_WRITER_H_
+
+#include <sys/uio.h>
+
+#include "boring_json.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* pieces shorter than this are copied, a reference costs an iovec and the kernel a lookup */
+#ifndef BO_JSON_IOVEC_WRITER_REF_MIN
+#define BO_JSON_IOVEC_WRITER_REF_MIN (64)
+#endif
+
+/**
+ * @brief Writer gathering the output as an iovec list, written to a file descriptor with writev
+ *
+ * Long pieces that stay valid until the flush (string bodies, keys) are referenced where they
+ * are, everything else is copied into a side buffer exposed as the inline window of `ctx`. The
+ * encoded value must therefore not change until bo_json_iovec_writer_flush() returns.
+ */
+struct bo_json_iovec_writer {
+	struct bo_json_writer ctx;
+	int fd;
+
+	struct iovec *iov;
+	size_t iov_cap;
+	size_t iov_len;
+
+	char *buf;
+	size_t cap;
+	// start of the side buffer content not referenced by iov yet
+	char *seg;
+};
+
+/**
+ * @brief Initialize an iovec writer
+ *
+ * @param[out] writer  The iovec writer
+ * @param[in]  fd      The file descriptor the output is written to
+ * @param[in]  iov     The iovec list, from 2 to IOV_MAX entries
+ * @param[in]  iov_cap The number of entries of iov
+ * @param[in]  buf     The side buffer holding the pieces which are copied
+ * @param[in]  cap     The capacity of the side buffer
+ */
+void bo_json_iovec_writer_init(struct bo_json_iovec_writer *writer, int fd, struct iovec *iov,
+			       size_t iov_cap, void *buf, size_t cap);
+
+/**
+ * @brief Write everything gathered so far with writev
+ *
+ * Must be called once the encoding is done, before the encoded value changes. The writer is
+ * called again whenever the iovec list or the side buffer is full.
+ *
+ * @param[in] writer The iovec writer
+ * @return BO_JSON_ERROR_IO if writev fails
+ */
+struct bo_json_error bo_json_iovec_writer_flush(struct bo_json_iovec_writer *writer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BORING_JSON_IOVEC_WRITER_H_ */
@@ -7,10 +7,33 @@
 extern "C" {
 #endif
 
+/*
+ * Buffers kept per thread by bo_json_mem_writer_release(), 0 disables the pool on targets
+ * without thread local storage
+ */
+#ifndef BO_JSON_MEM_WRITER_POOL_SIZE
+#define BO_JSON_MEM_WRITER_POOL_SIZE (4)
+#endif
+
+/**
+ * @brief Memory allocation of a memory writer, realloc() and free() of libc when not set
+ */
+struct bo_json_allocator {
+	void *(*resize)(void *ctx, void *ptr, size_t size);
+	void (*release)(void *ctx, void *ptr);
+	void *ctx;
+};
+
+/**
+ * @brief Writer collecting the output in a growing heap buffer
+ *
+ * The buffer grows by at least `increase_bytes` and at least doubles each time, up to `max_cap`.
+ */
 struct bo_json_mem_writer {
 	struct bo_json_writer ctx;
 	size_t max_cap;
 	size_t increase_bytes;
+	const struct bo_json_allocator *alloc;
 
 	void *buf;
 	size_t cap;
@@ -19,8 +42,64 @@ struct bo_json_mem_writer {
 
 void bo_json_mem_writer_init(struct bo_json_mem_writer *writer, size_t increase_bytes,
 			     size_t max_cap);
+
+/**
+ * @brief Initialize a memory writer allocating through the given hooks
+ *
+ * @param[out] writer         The memory writer
+ * @param[in]  increase_bytes The smallest growth of the buffer
+ * @param[in]  max_cap        The largest capacity of the buffer
+ * @param[in]  alloc          The allocator, which must outlive the writer, NULL for libc
+ */
+void bo_json_mem_writer_init_alloc(struct bo_json_mem_writer *writer, size_t increase_bytes,
+				   size_t max_cap, const struct bo_json_allocator *alloc);
+
 void bo_json_mem_writer_cleanup(struct bo_json_mem_writer *writer);
 
+/**
+ * @brief Grow the buffer up front so that len more bytes fit without another allocation
+ *
+ * @param[in] writer The memory writer
+ * @param[in] len    The number of bytes to make room for
+ * @return BO_JSON_ERROR_INSUFFICIENT_SPACE if it would exceed `max_cap` or the allocation fails
+ */
+struct bo_json_error bo_json_mem_writer_reserve(struct bo_json_mem_writer *writer, size_t len);
+
+/**
+ * @brief Forget the output but keep the buffer, so that the next encoding does not allocate
+ *
+ * @param[in] writer The memory writer
+ */
+void bo_json_mem_writer_reset(struct bo_json_mem_writer *writer);
+
+/**
+ * @brief Initialize a memory writer with a buffer released earlier on the same thread, if any
+ *
+ * Only writers using libc allocation share the pool. The buffer is reused only if it does not
+ * exceed `max_cap`.
+ *
+ * @param[out] writer         The memory writer
+ * @param[in]  increase_bytes The smallest growth of the buffer
+ * @param[in]  max_cap        The largest capacity of the buffer
+ */
+void bo_json_mem_writer_acquire(struct bo_json_mem_writer *writer, size_t increase_bytes,
+				size_t max_cap);
+
+/**
+ * @brief Give the buffer of a memory writer back to the pool of the calling thread
+ *
+ * The buffer is freed like bo_json_mem_writer_cleanup() does when the pool is full or the writer
+ * uses its own allocator. The writer is left empty.
+ *
+ * @param[in] writer The memory writer
+ */
+void bo_json_mem_writer_release(struct bo_json_mem_writer *writer);
+
+/**
+ * @brief Free the buffers pooled by the calling thread, e.g. before it exits
+ */
+void bo_json_mem_writer_pool_drain(void);
+
 #ifdef __cplusplus
 }
 #endif
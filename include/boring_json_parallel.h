@@ -0,0 +1,41 @@
+#ifndef BORING_JSON_PARALLEL_H_
+#define BORING_JSON_PARALLEL_H_
+
+#include "boring_json.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef BO_JSON_PARALLEL_MAX_THREADS
+#define BO_JSON_PARALLEL_MAX_THREADS (64)
+#endif
+
+/**
+ * @brief Encode an array with several threads
+ *
+ * The elements are split in contiguous ranges, one per thread. Each thread encodes its range into
+ * a buffer of its own, then the segments are written to the writer in order, between the brackets
+ * and separated by commas. The output is the same as bo_json_encode().
+ *
+ * An array inside an object is encoded on its own by passing the object and the descriptor of the
+ * array, like bo_json_encode() would for that attribute.
+ *
+ * @param[in] in        The value holding the array
+ * @param[in] in_desc   The description of the array
+ * @param[in] n_threads The number of threads, at most BO_JSON_PARALLEL_MAX_THREADS; fewer are
+ * used for short arrays
+ * @param[in] writer    The JSON writer
+ * @return BO_JSON_ERROR_NOT_SUPPORT if in_desc is not an array or n_threads is out of range,
+ * BO_JSON_ERROR_INSUFFICIENT_SPACE if a thread cannot be started or run out of memory, otherwise
+ * the first error of the ranges in order
+ */
+struct bo_json_error bo_json_encode_parallel(const void *in,
+					     const struct bo_json_value_desc *in_desc,
+					     size_t n_threads, struct bo_json_writer *writer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BORING_JSON_PARALLEL_H_ */
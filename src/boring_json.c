@@ -26,6 +26,8 @@ int bo_json_error_to_errno(const struct bo_json_error *err)
 		return -ENOTSUP;
 	case BO_JSON_ERROR_CONVERT:
 		return -EINVAL;
+	case BO_JSON_ERROR_IO:
+		return -EIO;
 	}
 
 	return -1;
@@ -0,0 +1,50 @@
+#include "boring_json_buffered_writer.h"
+#include "boring_json.h"
+
+#include <string.h>
+
+struct bo_json_error bo_json_buffered_writer_flush(struct bo_json_buffered_writer *writer)
+{
+	const size_t len = (size_t)(writer->ctx.pos - writer->buf);
+
+	writer->ctx.pos = writer->buf;
+	if (len == 0) {
+		return BO_JSON_OK();
+	}
+
+	return bo_json_writer_write(writer->next, writer->buf, len);
+}
+
+// only called when the data does not fit in what is left of the window
+static struct bo_json_error _buffered_write(struct bo_json_writer *writer, const void *data,
+					    size_t len)
+{
+	struct bo_json_buffered_writer *bwriter = (struct bo_json_buffered_writer *)writer;
+	struct bo_json_error err;
+
+	err = bo_json_buffered_writer_flush(bwriter);
+	if (err.err != BO_JSON_ERROR_NONE) {
+		return err;
+	}
+
+	// too large to be worth a copy
+	if (len >= bwriter->cap) {
+		return bo_json_writer_write(bwriter->next, data, len);
+	}
+
+	memcpy(bwriter->ctx.pos, data, len);
+	bwriter->ctx.pos += len;
+	return BO_JSON_OK();
+}
+
+void bo_json_buffered_writer_init(struct bo_json_buffered_writer *writer,
+				  struct bo_json_writer *next, void *buf, size_t cap)
+{
+	bo_json_writer_init(&writer->ctx, _buffered_write);
+	writer->next = next;
+	writer->buf = buf;
+	writer->cap = cap;
+
+	writer->ctx.pos = writer->buf;
+	writer->ctx.end = writer->buf + cap;
+}
@@ -55,6 +55,16 @@ struct bo_json_lexer {
 	const char *pos;
 };
 
+struct bo_json_decoder {
+	struct bo_json_lexer lexer;
+	unsigned int flags;
+	size_t depth;
+	bool track_changes;
+	bool changed;
+	// objects drop the attributes missing from the input, set for array elements of a merge
+	bool replace;
+};
+
 /**
  * @brief Skip all the whitespaces
  *
@@ -355,10 +365,14 @@ static struct bo_json_error lexer_expect_next(struct bo_json_lexer *lexer,
 	return BO_JSON_OK();
 }
 
-static struct bo_json_error decode_object(struct bo_json_lexer *lexer,
-					  const struct bo_json_value_desc *desc, void *out);
-static struct bo_json_error decode_array(struct bo_json_lexer *lexer,
-					 const struct bo_json_value_desc *desc, void *out);
+static struct bo_json_error decode_object(struct bo_json_decoder *decoder,
+					  const struct bo_json_value_desc *desc,
+					  const struct bo_json_projection *proj,
+					  struct bo_json_changes *changes, void *out);
+static struct bo_json_error decode_array(struct bo_json_decoder *decoder,
+					 const struct bo_json_value_desc *desc,
+					 const struct bo_json_projection *proj,
+					 struct bo_json_changes *changes, void *out);
 
 /**
  * @brief Decodes a null value from a JSON token and stores it in the specified output location.
@@ -367,12 +381,14 @@ static struct bo_json_error decode_array(struct bo_json_lexer *lexer,
  * @param[in] desc The description of the JSON value type
  * @param[out] out A base pointer to the output structure where the decoded null value will be
  * stored.
+ * @param[out] changed Set to true if the output was modified, NULL when not tracked.
  *
  * @return BO_JSON_ERROR_NONE if success
  * #return BO_JSON_ERROR_TYPE_NOT_MATCH if desc is not BO_JSON_VALUE_TYPE_NULL
  */
 static struct bo_json_error decode_null(const struct bo_json_token *token,
-					const struct bo_json_value_desc *desc, void *out)
+					const struct bo_json_value_desc *desc, void *out,
+					bool *changed)
 {
 	(void)out;
 
@@ -381,7 +397,12 @@ static struct bo_json_error decode_null(const struct bo_json_token *token,
 	}
 	if (desc->type != BO_JSON_VALUE_TYPE_NULL) {
 		if (desc->flags & BO_JSON_FLAGS_NULLABLE) {
-			*((unsigned char *)out + desc->flags_offset) |= BO_JSON_NULL_BIT;
+			unsigned char *flags = (unsigned char *)out + desc->flags_offset;
+
+			if (changed != NULL) {
+				*changed |= !(*flags & BO_JSON_NULL_BIT);
+			}
+			*flags |= BO_JSON_NULL_BIT;
 			return BO_JSON_OK();
 		}
 		return BO_JSON_ERROR(BO_JSON_ERROR_TYPE_NOT_MATCH, token->start, desc);
@@ -397,12 +418,14 @@ static struct bo_json_error decode_null(const struct bo_json_token *token,
  * @param[in] desc The description of the JSON value type
  * @param[out] out A base pointer to the output structure where the decoded true value will be
  * stored.
+ * @param[out] changed Set to true if the output was modified, NULL when not tracked.
  *
  * @return BO_JSON_ERROR_NONE if success
  * #return BO_JSON_ERROR_TYPE_NOT_MATCH if desc is not BO_JSON_VALUE_TYPE_BOOL
  */
 static struct bo_json_error decode_true(const struct bo_json_token *token,
-					const struct bo_json_value_desc *desc, void *out)
+					const struct bo_json_value_desc *desc, void *out,
+					bool *changed)
 {
 	if (desc == NULL) {
 		return BO_JSON_OK();
@@ -411,7 +434,12 @@ static struct bo_json_error decode_true(const struct bo_json_token *token,
 		return BO_JSON_ERROR(BO_JSON_ERROR_TYPE_NOT_MATCH, token->start, desc);
 	}
 
-	*((bool *)((char *)out + desc->value_offset)) = true;
+	bool *value = (bool *)((char *)out + desc->value_offset);
+
+	if (changed != NULL) {
+		*changed |= (*value != true);
+	}
+	*value = true;
 
 	return BO_JSON_OK();
 }
@@ -423,12 +451,14 @@ static struct bo_json_error decode_true(const struct bo_json_token *token,
  * @param[in] desc The description of the JSON value type
  * @param[out] out A base pointer to the output structure where the decoded false value will be
  * stored.
+ * @param[out] changed Set to true if the output was modified, NULL when not tracked.
  *
  * @return BO_JSON_ERROR_NONE if success
  * #return BO_JSON_ERROR_TYPE_NOT_MATCH if desc is not BO_JSON_VALUE_TYPE_BOOL
  */
 static struct bo_json_error decode_false(const struct bo_json_token *token,
-					 const struct bo_json_value_desc *desc, void *out)
+					 const struct bo_json_value_desc *desc, void *out,
+					 bool *changed)
 {
 	if (desc == NULL) {
 		return BO_JSON_OK();
@@ -437,11 +467,33 @@ static struct bo_json_error decode_false(const struct bo_json_token *token,
 		return BO_JSON_ERROR(BO_JSON_ERROR_TYPE_NOT_MATCH, token->start, desc);
 	}
 
-	*((bool *)((char *)out + desc->value_offset)) = false;
+	bool *value = (bool *)((char *)out + desc->value_offset);
+
+	if (changed != NULL) {
+		*changed |= (*value != false);
+	}
+	*value = false;
 
 	return BO_JSON_OK();
 }
 
+/**
+ * @brief Store one character of a decoded string, noting whether it differs from the old one
+ *
+ * @param[out] dest    Where to store the character
+ * @param[in]  c       The character
+ * @param[out] changed Set to true if the stored character differs, NULL when not tracked
+ * @return Position of the next character
+ */
+static inline char *string_put(char *dest, char c, bool *changed)
+{
+	if (changed != NULL) {
+		*changed |= (*dest != c);
+	}
+	*dest = c;
+	return dest + 1;
+}
+
 /**
  * Decodes a string value from a JSON token and stores it in the specified output location.
  *
@@ -449,13 +501,15 @@ static struct bo_json_error decode_false(const struct bo_json_token *token,
  * @param[in] desc The description of the JSON value type
  * @param[out] out A base pointer to the output structure where the decoded string value will be
  * stored.
+ * @param[out] changed Set to true if the output was modified, NULL when not tracked.
  *
  * @return BO_JSON_ERROR_NONE if success
  * #return BO_JSON_ERROR_TYPE_NOT_MATCH if desc is not BO_JSON_VALUE_TYPE_CSTR
  * #return BO_JSON_ERROR_SUFFICIENT_SPACE if token length greater or equal to capacity of string
  */
 static struct bo_json_error decode_string(const struct bo_json_token *token,
-					  const struct bo_json_value_desc *desc, void *out)
+					  const struct bo_json_value_desc *desc, void *out,
+					  bool *changed)
 {
 	if (desc == NULL) {
 		return BO_JSON_OK();
@@ -486,7 +540,7 @@ static struct bo_json_error decode_string(const struct bo_json_token *token,
 					return BO_JSON_ERROR(BO_JSON_ERROR_INSUFFICIENT_SPACE, src,
 							     desc);
 				}
-				*dest++ = c;
+				dest = string_put(dest, c, changed);
 				len++;
 				break;
 			case 'b':
@@ -494,7 +548,7 @@ static struct bo_json_error decode_string(const struct bo_json_token *token,
 					return BO_JSON_ERROR(BO_JSON_ERROR_INSUFFICIENT_SPACE, src,
 							     desc);
 				}
-				*dest++ = '\b';
+				dest = string_put(dest, '\b', changed);
 				len++;
 				break;
 			case 'f':
@@ -502,7 +556,7 @@ static struct bo_json_error decode_string(const struct bo_json_token *token,
 					return BO_JSON_ERROR(BO_JSON_ERROR_INSUFFICIENT_SPACE, src,
 							     desc);
 				}
-				*dest++ = '\f';
+				dest = string_put(dest, '\f', changed);
 				len++;
 				break;
 			case 'n':
@@ -510,7 +564,7 @@ static struct bo_json_error decode_string(const struct bo_json_token *token,
 					return BO_JSON_ERROR(BO_JSON_ERROR_INSUFFICIENT_SPACE, src,
 							     desc);
 				}
-				*dest++ = '\n';
+				dest = string_put(dest, '\n', changed);
 				len++;
 				break;
 			case 'r':
@@ -518,7 +572,7 @@ static struct bo_json_error decode_string(const struct bo_json_token *token,
 					return BO_JSON_ERROR(BO_JSON_ERROR_INSUFFICIENT_SPACE, src,
 							     desc);
 				}
-				*dest++ = '\r';
+				dest = string_put(dest, '\r', changed);
 				len++;
 				break;
 			case 't':
@@ -526,7 +580,7 @@ static struct bo_json_error decode_string(const struct bo_json_token *token,
 					return BO_JSON_ERROR(BO_JSON_ERROR_INSUFFICIENT_SPACE, src,
 							     desc);
 				}
-				*dest++ = '\t';
+				dest = string_put(dest, '\t', changed);
 				len++;
 				break;
 			case 'u': {
@@ -558,7 +612,7 @@ static struct bo_json_error decode_string(const struct bo_json_token *token,
 							BO_JSON_ERROR_INSUFFICIENT_SPACE, src,
 							desc);
 					}
-					*dest++ = (char)codepoint;
+					dest = string_put(dest, (char)codepoint, changed);
 					len++;
 				} else if (codepoint <= 0x7FF) {
 					if (len + 2 >= cap) {
@@ -566,8 +620,10 @@ static struct bo_json_error decode_string(const struct bo_json_token *token,
 							BO_JSON_ERROR_INSUFFICIENT_SPACE, src,
 							desc);
 					}
-					*dest++ = (char)(0xC0 | (codepoint >> 6));
-					*dest++ = (char)(0x80 | (codepoint & 0x3F));
+					dest = string_put(dest, (char)(0xC0 | (codepoint >> 6)),
+							  changed);
+					dest = string_put(dest, (char)(0x80 | (codepoint & 0x3F)),
+							  changed);
 					len += 2;
 				} else {
 					if (len + 3 >= cap) {
@@ -575,9 +631,13 @@ static struct bo_json_error decode_string(const struct bo_json_token *token,
 							BO_JSON_ERROR_INSUFFICIENT_SPACE, src,
 							desc);
 					}
-					*dest++ = (char)(0xE0 | (codepoint >> 12));
-					*dest++ = (char)(0x80 | ((codepoint >> 6) & 0x3F));
-					*dest++ = (char)(0x80 | (codepoint & 0x3F));
+					dest = string_put(dest, (char)(0xE0 | (codepoint >> 12)),
+							  changed);
+					dest = string_put(dest,
+							  (char)(0x80 | ((codepoint >> 6) & 0x3F)),
+							  changed);
+					dest = string_put(dest, (char)(0x80 | (codepoint & 0x3F)),
+							  changed);
 					len += 3;
 				}
 				break;
@@ -589,7 +649,7 @@ static struct bo_json_error decode_string(const struct bo_json_token *token,
 			if (len + 1 >= cap) {
 				return BO_JSON_ERROR(BO_JSON_ERROR_INSUFFICIENT_SPACE, src, desc);
 			}
-			*dest++ = *src;
+			dest = string_put(dest, *src, changed);
 			len++;
 		}
 		src++;
@@ -598,7 +658,7 @@ static struct bo_json_error decode_string(const struct bo_json_token *token,
 	if (len >= cap) {
 		return BO_JSON_ERROR(BO_JSON_ERROR_INSUFFICIENT_SPACE, src, desc);
 	}
-	*dest = '\0';
+	string_put(dest, '\0', changed);
 
 	return BO_JSON_OK();
 }
@@ -610,13 +670,15 @@ static struct bo_json_error decode_string(const struct bo_json_token *token,
  * @param[in] desc The description of the JSON value type
  * @param[out] out A base pointer to the output structure where the decoded number value will be
  * stored.
+ * @param[out] changed Set to true if the output was modified, NULL when not tracked.
  *
  * @return BO_JSON_ERROR_NONE if success
  * #return BO_JSON_ERROR_TYPE_NOT_MATCH if desc is not BO_JSON_VALUE_TYPE_INT and
  * BO_JSON_VALUE_TYPE_DOUBLE
  */
 static struct bo_json_error decode_number(const struct bo_json_token *token,
-					  const struct bo_json_value_desc *desc, void *out)
+					  const struct bo_json_value_desc *desc, void *out,
+					  bool *changed)
 {
 	if (desc == NULL) {
 		return BO_JSON_OK();
@@ -634,46 +696,145 @@ static struct bo_json_error decode_number(const struct bo_json_token *token,
 
 	strncpy(buf, token->start, token_len(token));
 
+	void *value = (char *)out + desc->value_offset;
+
 	if (desc->type == BO_JSON_VALUE_TYPE_INT) {
-		*((int *)((char *)out + desc->value_offset)) = (int)strtol(buf, NULL, 10);
+		const int v = (int)strtol(buf, NULL, 10);
+		if (changed != NULL) {
+			*changed |= (*(int *)value != v);
+		}
+		*(int *)value = v;
 	} else if (desc->type == BO_JSON_VALUE_TYPE_INT64) {
-		*((int64_t *)((char *)out + desc->value_offset)) = (int64_t)strtoll(buf, NULL, 10);
+		const int64_t v = (int64_t)strtoll(buf, NULL, 10);
+		if (changed != NULL) {
+			*changed |= (*(int64_t *)value != v);
+		}
+		*(int64_t *)value = v;
 	} else {
-		*((double *)((char *)out + desc->value_offset)) = strtod(buf, NULL);
+		const double v = strtod(buf, NULL);
+		if (changed != NULL) {
+			*changed |= (*(double *)value != v);
+		}
+		*(double *)value = v;
 	}
 
 	return BO_JSON_OK();
 }
 
-static struct bo_json_error decode_value(struct bo_json_lexer *lexer,
-					 const struct bo_json_value_desc *desc, void *out)
+/**
+ * @brief Clear the null bit of a nullable value after a non-null value was decoded into it
+ *
+ * @param[in]  desc    The description of the value, may be NULL
+ * @param[out] out     A base pointer to the output structure
+ * @param[out] changed Set to true if the null bit was set, NULL when not tracked
+ */
+static void clear_null_bit(const struct bo_json_value_desc *desc, void *out, bool *changed)
 {
-	struct bo_json_token token;
-	struct bo_json_error err;
+	if (desc == NULL || !(desc->flags & BO_JSON_FLAGS_NULLABLE)) {
+		return;
+	}
 
-	err = lexer_next(lexer, &token);
-	if (err.err != BO_JSON_ERROR_NONE) {
-		return err;
+	unsigned char *flags = (unsigned char *)out + desc->flags_offset;
+
+	if (changed != NULL) {
+		*changed |= (*flags & BO_JSON_NULL_BIT) != 0;
 	}
+	*flags &= (unsigned char)~BO_JSON_NULL_BIT;
+}
 
-	switch (token.type) {
+/**
+ * @brief Decode a null, boolean, string or number token
+ *
+ * @param[in]  token   The token to decode
+ * @param[in]  desc    The description of the value, NULL to skip it
+ * @param[out] out     A base pointer to the output structure
+ * @param[out] changed Set to true if the output was modified, NULL when not tracked
+ * @return BO_JSON_ERROR_NONE if success
+ * @return BO_JSON_ERROR_NOT_SUPPORT if the token does not start a scalar value
+ */
+static struct bo_json_error decode_scalar(const struct bo_json_token *token,
+					  const struct bo_json_value_desc *desc, void *out,
+					  bool *changed)
+{
+	struct bo_json_error err;
+
+	switch (token->type) {
 	case BO_JSON_TOKEN_NULL:
-		return decode_null(&token, desc, out);
+		return decode_null(token, desc, out, changed);
 	case BO_JSON_TOKEN_TRUE:
-		return decode_true(&token, desc, out);
+		err = decode_true(token, desc, out, changed);
+		break;
 	case BO_JSON_TOKEN_FALSE:
-		return decode_false(&token, desc, out);
+		err = decode_false(token, desc, out, changed);
+		break;
 	case BO_JSON_TOKEN_STRING:
-		return decode_string(&token, desc, out);
+		err = decode_string(token, desc, out, changed);
+		break;
 	case BO_JSON_TOKEN_NUMBER:
-		return decode_number(&token, desc, out);
+		err = decode_number(token, desc, out, changed);
+		break;
+	default:
+		return BO_JSON_ERROR(BO_JSON_ERROR_NOT_SUPPORT, token->start, desc);
+	}
+
+	if (err.err == BO_JSON_ERROR_NONE) {
+		clear_null_bit(desc, out, changed);
+	}
+
+	return err;
+}
+
+static struct bo_json_error decode_value(struct bo_json_decoder *decoder,
+					 const struct bo_json_value_desc *desc,
+					 const struct bo_json_projection *proj,
+					 struct bo_json_changes *changes, void *out)
+{
+	struct bo_json_token token;
+	struct bo_json_error err;
+	bool *changed = decoder->track_changes ? &decoder->changed : NULL;
+
+	err = lexer_next(&decoder->lexer, &token);
+	if (err.err != BO_JSON_ERROR_NONE) {
+		return err;
+	}
+
+	switch (token.type) {
 	case BO_JSON_TOKEN_OBJECT_START:
-		return decode_object(lexer, desc, out);
+		err = decode_object(decoder, desc, proj, changes, out);
+		break;
 	case BO_JSON_TOKEN_ARRAY_START:
-		return decode_array(lexer, desc, out);
+		err = decode_array(decoder, desc, proj, changes, out);
+		break;
 	default:
-		return BO_JSON_ERROR(BO_JSON_ERROR_NOT_SUPPORT, token.start, desc);
+		return decode_scalar(&token, desc, out, changed);
+	}
+
+	if (err.err == BO_JSON_ERROR_NONE) {
+		clear_null_bit(desc, out, changed);
+	}
+
+	return err;
+}
+
+/**
+ * @brief Find the attribute of an object matching a key
+ *
+ * @param[in] desc The description of the object, may be NULL
+ * @param[in] key  Pointer of token which contain the key
+ * @return Index of the matched attribute, or the number of attributes if none matches
+ */
+static size_t find_attr(const struct bo_json_value_desc *desc, const struct bo_json_token *key)
+{
+	const size_t descs_len = (desc != NULL) ? desc->object.n_attr_descs : 0;
+	size_t i;
+
+	for (i = 0; i < descs_len; i++) {
+		if (strncmp(desc->object.attr_descs[i].name, key->start, token_len(key)) == 0) {
+			break;
+		}
 	}
+
+	return i;
 }
 
 /**
@@ -682,54 +843,171 @@ static struct bo_json_error decode_value(struct bo_json_lexer *lexer,
  * This function decodes a key-value pair from a JSON lexer, matching the key with the provided
  * description.
  *
- * @param[in] lexer Pointer of lexer
+ * @param[in] decoder Pointer of decoder
  * @param[in] key Pointer of token which contain the key
  * @param[in] desc The description of the object value.
+ * @param[in] proj The projection of the object value, NULL to decode every attribute.
+ * @param[in,out] changes Changed attributes of the object value, NULL if not tracked.
  * @param[out] out Pointer to the output value.
+ * @param[in,out] found Bit set of decoded attributes, updated with the matched attribute.
  * @return BO_JSON_ERROR_NONE if success
  */
-static struct bo_json_error decode_object_key_value(struct bo_json_lexer *lexer,
+static struct bo_json_error decode_object_key_value(struct bo_json_decoder *decoder,
 						    const struct bo_json_token *key,
 						    const struct bo_json_value_desc *desc,
-						    void *out)
+						    const struct bo_json_projection *proj,
+						    struct bo_json_changes *changes, void *out,
+						    uint64_t *found)
 {
 	struct bo_json_error err;
 
 	const struct bo_json_obj_attr_desc *descs = (desc != NULL) ? desc->object.attr_descs : NULL;
 	const size_t descs_len = (desc != NULL) ? desc->object.n_attr_descs : 0;
+	const size_t i = find_attr(desc, key);
 
-	for (size_t i = 0; i < descs_len; i++) {
-		if (strncmp(descs[i].name, key->start, token_len(key)) != 0) {
-			continue;
+	if (i < descs_len) {
+		if (!bo_json_projection_selects(proj, i)) {
+			BO_DEBUG("decode obj: projected out: name='%s'", descs[i].name);
+			return decode_value(decoder, NULL, NULL, NULL, 0);
 		}
 
 		BO_DEBUG("decode obj: matched: name='%s' type=%d offset=%lu", descs[i].name,
 			 descs[i].desc.type, descs[i].desc.value_offset);
 
-		err = decode_value(lexer, &descs[i].desc, out);
+		const bool outer_changed = decoder->changed;
+		bool *exist = (bool *)((char *)out + descs[i].exist_offset);
+
+		decoder->changed = false;
+		err = decode_value(decoder, &descs[i].desc, bo_json_projection_attr(proj, i),
+				   bo_json_changes_attr(changes, i), out);
 		if (err.err != BO_JSON_ERROR_NONE) {
 			return err;
 		}
 
-		if (desc != NULL) {
-			*((bool *)((char *)out + descs[i].exist_offset)) = true;
+		if (decoder->track_changes) {
+			decoder->changed |= !*exist;
+		}
+		*exist = true;
+
+		if (i < BO_JSON_PROJECTION_BITS) {
+			*found |= BO_JSON_PROJECTION_BIT(i);
+			if (decoder->changed && changes != NULL) {
+				changes->mask |= BO_JSON_PROJECTION_BIT(i);
+			}
 		}
+		decoder->changed |= outer_changed;
 
 		return BO_JSON_OK();
 	}
 
-	return decode_value(lexer, NULL, 0);
+	return decode_value(decoder, NULL, NULL, NULL, 0);
 }
 
-static struct bo_json_error decode_object(struct bo_json_lexer *lexer,
-					  const struct bo_json_value_desc *desc, void *out)
+/**
+ * @brief Clear the exist field and null bit of every attribute of an object
+ *
+ * Used by BO_JSON_DECODE_FLAGS_RESET_PRESENCE so a reused output structure only needs its
+ * presence bookkeeping reset instead of being zeroed as a whole.
+ *
+ * @param[in]  desc The description of the object
+ * @param[out] out  Pointer to the object storage
+ */
+static void reset_object_presence(const struct bo_json_value_desc *desc, void *out)
+{
+	for (size_t i = 0; i < desc->object.n_attr_descs; i++) {
+		const struct bo_json_obj_attr_desc *attr = &desc->object.attr_descs[i];
+
+		*((bool *)((char *)out + attr->exist_offset)) = false;
+		if (attr->desc.flags & BO_JSON_FLAGS_NULLABLE) {
+			*((unsigned char *)out + attr->desc.flags_offset) &=
+				(unsigned char)~BO_JSON_NULL_BIT;
+		}
+	}
+}
+
+/**
+ * @brief Prepare an object to be replaced by the decoded one
+ *
+ * Attributes past the first `BO_JSON_PROJECTION_BITS` are not tracked and lose their presence
+ * right away, the others are returned so that the ones missing from the input can be dropped
+ * once the object is decoded.
+ *
+ * @param[in] desc    The description of the object
+ * @param[in] proj    The projection of the object, attributes projected out are left untouched
+ * @param[in,out] out Pointer to the object storage
+ * @return Bit `i` set for every present attribute `i` among the first BO_JSON_PROJECTION_BITS
+ */
+static uint64_t begin_object_replace(const struct bo_json_value_desc *desc,
+				     const struct bo_json_projection *proj, void *out)
+{
+	uint64_t present = 0;
+
+	for (size_t i = 0; i < desc->object.n_attr_descs; i++) {
+		bool *exist = (bool *)((char *)out + desc->object.attr_descs[i].exist_offset);
+
+		if (!*exist || !bo_json_projection_selects(proj, i)) {
+			continue;
+		}
+
+		if (i < BO_JSON_PROJECTION_BITS) {
+			present |= BO_JSON_PROJECTION_BIT(i);
+		} else {
+			*exist = false;
+		}
+	}
+
+	return present;
+}
+
+/**
+ * @brief Bit set of the attributes of an object selected by a projection
+ *
+ * @param[in] desc The description of the object
+ * @param[in] proj The projection of the object, NULL to select every attribute
+ * @return Bit `i` set for every selected attribute `i`
+ */
+static uint64_t selected_attrs(const struct bo_json_value_desc *desc,
+			       const struct bo_json_projection *proj)
 {
+	uint64_t selected = 0;
+
+	for (size_t i = 0; i < desc->object.n_attr_descs; i++) {
+		if (bo_json_projection_selects(proj, i)) {
+			selected |= BO_JSON_PROJECTION_BIT(i);
+		}
+	}
+
+	return selected;
+}
+
+static struct bo_json_error decode_object(struct bo_json_decoder *decoder,
+					  const struct bo_json_value_desc *desc,
+					  const struct bo_json_projection *proj,
+					  struct bo_json_changes *changes, void *out)
+{
+	struct bo_json_lexer *lexer = &decoder->lexer;
 	struct bo_json_error err;
 
+	// only the outermost object may stop early, nested values are always decoded completely
+	const bool stop_when_complete =
+		(decoder->flags & BO_JSON_DECODE_FLAGS_STOP_WHEN_COMPLETE) && decoder->depth == 0 &&
+		desc != NULL && desc->object.n_attr_descs <= BO_JSON_PROJECTION_BITS;
+	const uint64_t wanted = stop_when_complete ? selected_attrs(desc, proj) : 0;
+	uint64_t found = 0;
+	uint64_t had = 0;
+
 	if (desc != NULL) {
 		out = (char *)out + desc->value_offset;
+
+		if (decoder->flags & BO_JSON_DECODE_FLAGS_RESET_PRESENCE) {
+			reset_object_presence(desc, out);
+		} else if (decoder->replace) {
+			had = begin_object_replace(desc, proj, out);
+		}
 	}
 
+	decoder->depth++;
+
 	for (;;) {
 		struct bo_json_token key, colon, next;
 
@@ -746,11 +1024,17 @@ static struct bo_json_error decode_object(struct bo_json_lexer *lexer,
 		}
 
 		// value
-		err = decode_object_key_value(lexer, &key, desc, out);
+		err = decode_object_key_value(decoder, &key, desc, proj, changes, out, &found);
 		if (err.err != BO_JSON_ERROR_NONE) {
 			return err;
 		}
 
+		if (stop_when_complete && (found & wanted) == wanted) {
+			BO_DEBUG("decode obj: all wanted attributes found, stop at %ld",
+				 (long)(lexer->pos - lexer->start));
+			goto DONE;
+		}
+
 		// , or }
 		err = lexer_next(lexer, &next);
 		if (err.err != BO_JSON_ERROR_NONE) {
@@ -767,20 +1051,45 @@ static struct bo_json_error decode_object(struct bo_json_lexer *lexer,
 	}
 
 DONE:
+	decoder->depth--;
+
+	// attributes missing from a replacing object are gone, which is a change too
+	const uint64_t removed = had & ~found;
+
+	if (removed != 0) {
+		const struct bo_json_obj_attr_desc *descs = desc->object.attr_descs;
+
+		for (size_t i = 0; i < BO_JSON_PROJECTION_BITS; i++) {
+			if (removed & BO_JSON_PROJECTION_BIT(i)) {
+				*((bool *)((char *)out + descs[i].exist_offset)) = false;
+			}
+		}
+
+		decoder->changed = true;
+		if (changes != NULL) {
+			changes->mask |= removed;
+		}
+	}
+
 	return BO_JSON_OK();
 }
 
 /**
  * @brief Decode JSON array and store values into out (only if desc is not NULL)
  *
- * @param[in]  lexer  pointer of lexer
- * @param[in]  desc   pointer of descriptor
- * @param[out] out    pointer of variable to store to
+ * @param[in]  decoder pointer of decoder
+ * @param[in]  desc    pointer of descriptor
+ * @param[in]  proj    projection applied to every element, NULL for none
+ * @param[in,out] changes changed attributes accumulated over the elements, NULL if not tracked
+ * @param[out] out     pointer of variable to store to
  * @return
  */
-static struct bo_json_error decode_array(struct bo_json_lexer *lexer,
-					 const struct bo_json_value_desc *desc, void *out)
+static struct bo_json_error decode_array(struct bo_json_decoder *decoder,
+					 const struct bo_json_value_desc *desc,
+					 const struct bo_json_projection *proj,
+					 struct bo_json_changes *changes, void *out)
 {
+	struct bo_json_lexer *lexer = &decoder->lexer;
 	struct bo_json_error err;
 
 	const struct bo_json_value_desc *elem_attr =
@@ -788,12 +1097,20 @@ static struct bo_json_error decode_array(struct bo_json_lexer *lexer,
 	const size_t elem_size = (desc != NULL) ? desc->array.elem_size : 0;
 	void *array_base = (char *)out + ((desc != NULL) ? desc->value_offset : 0);
 
+	// a merge replaces the elements, object elements keep nothing of what they held before
+	const bool replace = decoder->replace;
+
+	decoder->depth++;
+
 	size_t count = 0;
 	while (desc == NULL || count < desc->array.capacity) {
 		struct bo_json_token next;
 
 		// value
-		err = decode_value(lexer, elem_attr, (char *)array_base + (count * elem_size));
+		decoder->replace = decoder->track_changes;
+		err = decode_value(decoder, elem_attr, proj, changes,
+				   (char *)array_base + (count * elem_size));
+		decoder->replace = replace;
 		if (err.err != BO_JSON_ERROR_NONE) {
 			return err;
 		}
@@ -816,27 +1133,352 @@ static struct bo_json_error decode_array(struct bo_json_lexer *lexer,
 	}
 
 DONE:
+	decoder->depth--;
+
 	if (desc != NULL) {
-		*((size_t *)((char *)out + desc->array.count_offset)) = count;
+		size_t *count_ptr = (size_t *)((char *)out + desc->array.count_offset);
+
+		if (decoder->track_changes) {
+			decoder->changed |= (*count_ptr != count);
+		}
+		*count_ptr = count;
 	}
 
 	return BO_JSON_OK();
 }
 
+struct bo_json_error bo_json_decode_ex(const char *in, const size_t in_len,
+				       const struct bo_json_value_desc *obj_desc, void *out,
+				       unsigned int flags, const struct bo_json_projection *proj)
+{
+	struct bo_json_decoder decoder = {
+		.lexer =
+			{
+				.start = in,
+				.pos = in,
+				.end = in + in_len,
+			},
+		.flags = flags,
+		.depth = 0,
+	};
+
+	struct bo_json_error err = decode_value(&decoder, obj_desc, proj, NULL, out);
+	if (err.err != BO_JSON_ERROR_NONE) {
+		return err;
+	}
+
+	err.pos = decoder.lexer.pos;
+	return err;
+}
+
 struct bo_json_error bo_json_decode(const char *in, const size_t in_len,
 				    const struct bo_json_value_desc *obj_desc, void *out)
 {
-	struct bo_json_lexer lexer = {
-		.start = in,
-		.pos = in,
-		.end = in + in_len,
+	return bo_json_decode_ex(in, in_len, obj_desc, out, BO_JSON_DECODE_FLAGS_NONE, NULL);
+}
+
+/**
+ * @brief Clear a tree of changed attributes before it is filled by a merge
+ *
+ * @param[in]  desc    The description of the value the tree belongs to
+ * @param[out] changes The tree of changed attributes
+ */
+static void clear_changes(const struct bo_json_value_desc *desc, struct bo_json_changes *changes)
+{
+	changes->mask = 0;
+
+	if (desc != NULL && desc->type == BO_JSON_VALUE_TYPE_ARRAY) {
+		desc = desc->array.elem_attr_desc;
+	}
+	if (desc == NULL || desc->type != BO_JSON_VALUE_TYPE_OBJECT || changes->attrs == NULL) {
+		return;
+	}
+
+	for (size_t i = 0; i < desc->object.n_attr_descs; i++) {
+		if (changes->attrs[i] != NULL) {
+			clear_changes(&desc->object.attr_descs[i].desc, changes->attrs[i]);
+		}
+	}
+}
+
+struct bo_json_error bo_json_decode_merge(const char *in, const size_t in_len,
+					  const struct bo_json_value_desc *obj_desc, void *out,
+					  struct bo_json_changes *changes)
+{
+	struct bo_json_decoder decoder = {
+		.lexer =
+			{
+				.start = in,
+				.pos = in,
+				.end = in + in_len,
+			},
+		.flags = BO_JSON_DECODE_FLAGS_NONE,
+		.depth = 0,
+		.track_changes = true,
+	};
+
+	if (changes != NULL) {
+		clear_changes(obj_desc, changes);
+	}
+
+	struct bo_json_error err = decode_value(&decoder, obj_desc, NULL, changes, out);
+	if (err.err != BO_JSON_ERROR_NONE) {
+		return err;
+	}
+
+	err.pos = decoder.lexer.pos;
+	return err;
+}
+
+static struct bo_json_error decode_multi_object(struct bo_json_decoder *decoder,
+						const struct bo_json_decode_target *targets,
+						size_t n_targets);
+static struct bo_json_error decode_multi_array(struct bo_json_decoder *decoder,
+					       const struct bo_json_decode_target *targets,
+					       size_t n_targets);
+
+/**
+ * @brief Decode one JSON value into every target at once
+ *
+ * The value is lexed a single time; scalars are converted for each target from the same token and
+ * objects/arrays recurse with the targets whose descriptors contain the current key/element.
+ *
+ * @param[in] decoder   pointer of decoder
+ * @param[in] targets   targets to decode into, every desc is not NULL
+ * @param[in] n_targets number of targets, at most BO_JSON_DECODE_MULTI_MAX
+ * @return BO_JSON_ERROR_NONE if success
+ */
+static struct bo_json_error decode_multi_value(struct bo_json_decoder *decoder,
+					       const struct bo_json_decode_target *targets,
+					       size_t n_targets)
+{
+	struct bo_json_token token;
+	struct bo_json_error err;
+
+	if (n_targets <= 1) {
+		return (n_targets == 0)
+			       ? decode_value(decoder, NULL, NULL, NULL, 0)
+			       : decode_value(decoder, targets[0].desc, NULL, NULL, targets[0].out);
+	}
+
+	err = lexer_next(&decoder->lexer, &token);
+	if (err.err != BO_JSON_ERROR_NONE) {
+		return err;
+	}
+
+	if (token.type == BO_JSON_TOKEN_OBJECT_START || token.type == BO_JSON_TOKEN_ARRAY_START) {
+		const enum bo_json_value_type type = (token.type == BO_JSON_TOKEN_OBJECT_START)
+							     ? BO_JSON_VALUE_TYPE_OBJECT
+							     : BO_JSON_VALUE_TYPE_ARRAY;
+
+		// the targets are walked together, they must agree on the shape of the value
+		for (size_t k = 0; k < n_targets; k++) {
+			if (targets[k].desc->type != type) {
+				return BO_JSON_ERROR(BO_JSON_ERROR_TYPE_NOT_MATCH, token.start,
+						     targets[k].desc);
+			}
+		}
+	}
+
+	switch (token.type) {
+	case BO_JSON_TOKEN_OBJECT_START:
+		err = decode_multi_object(decoder, targets, n_targets);
+		break;
+	case BO_JSON_TOKEN_ARRAY_START:
+		err = decode_multi_array(decoder, targets, n_targets);
+		break;
+	default:
+		for (size_t k = 0; k < n_targets; k++) {
+			err = decode_scalar(&token, targets[k].desc, targets[k].out, NULL);
+			if (err.err != BO_JSON_ERROR_NONE) {
+				return err;
+			}
+		}
+		return BO_JSON_OK();
+	}
+
+	if (err.err != BO_JSON_ERROR_NONE) {
+		return err;
+	}
+
+	for (size_t k = 0; k < n_targets; k++) {
+		clear_null_bit(targets[k].desc, targets[k].out, NULL);
+	}
+
+	return BO_JSON_OK();
+}
+
+static struct bo_json_error decode_multi_object(struct bo_json_decoder *decoder,
+						const struct bo_json_decode_target *targets,
+						size_t n_targets)
+{
+	struct bo_json_lexer *lexer = &decoder->lexer;
+	struct bo_json_error err;
+	void *objs[BO_JSON_DECODE_MULTI_MAX];
+
+	for (size_t k = 0; k < n_targets; k++) {
+		objs[k] = (char *)targets[k].out + targets[k].desc->value_offset;
+	}
+
+	decoder->depth++;
+
+	for (;;) {
+		struct bo_json_token key, colon, next;
+		struct bo_json_decode_target attrs[BO_JSON_DECODE_MULTI_MAX];
+		bool *exists[BO_JSON_DECODE_MULTI_MAX];
+		size_t n_attrs = 0;
+
+		// key
+		err = lexer_expect_next(lexer, &key, BO_JSON_TOKEN_STRING);
+		if (err.err != BO_JSON_ERROR_NONE) {
+			return err;
+		}
+
+		// :
+		err = lexer_expect_next(lexer, &colon, BO_JSON_TOKEN_COLON);
+		if (err.err != BO_JSON_ERROR_NONE) {
+			return err;
+		}
+
+		// value, written to every target which has the key
+		for (size_t k = 0; k < n_targets; k++) {
+			const struct bo_json_value_desc *desc = targets[k].desc;
+			const size_t i = find_attr(desc, &key);
+
+			if (i < desc->object.n_attr_descs) {
+				const struct bo_json_obj_attr_desc *attr =
+					&desc->object.attr_descs[i];
+
+				attrs[n_attrs].desc = &attr->desc;
+				attrs[n_attrs].out = objs[k];
+				exists[n_attrs] = (bool *)((char *)objs[k] + attr->exist_offset);
+				n_attrs++;
+			}
+		}
+
+		err = decode_multi_value(decoder, attrs, n_attrs);
+		if (err.err != BO_JSON_ERROR_NONE) {
+			return err;
+		}
+
+		for (size_t k = 0; k < n_attrs; k++) {
+			*exists[k] = true;
+		}
+
+		// , or }
+		err = lexer_next(lexer, &next);
+		if (err.err != BO_JSON_ERROR_NONE) {
+			return err;
+		}
+
+		if (next.type == BO_JSON_TOKEN_COMMA) {
+			continue;
+		} else if (next.type == BO_JSON_TOKEN_OBJECT_END) {
+			break;
+		} else {
+			return BO_JSON_ERROR(BO_JSON_ERROR_INVALID_JSON, next.start, NULL);
+		}
+	}
+
+	decoder->depth--;
+	return BO_JSON_OK();
+}
+
+static struct bo_json_error decode_multi_array(struct bo_json_decoder *decoder,
+					       const struct bo_json_decode_target *targets,
+					       size_t n_targets)
+{
+	struct bo_json_lexer *lexer = &decoder->lexer;
+	struct bo_json_error err;
+	size_t counts[BO_JSON_DECODE_MULTI_MAX] = {0};
+
+	decoder->depth++;
+
+	for (;;) {
+		struct bo_json_token next;
+		struct bo_json_decode_target elems[BO_JSON_DECODE_MULTI_MAX];
+		size_t n_elems = 0;
+
+		// value, written to every target which still has room for it
+		for (size_t k = 0; k < n_targets; k++) {
+			const struct bo_json_value_desc *desc = targets[k].desc;
+
+			if (counts[k] < desc->array.capacity) {
+				elems[n_elems].desc = desc->array.elem_attr_desc;
+				elems[n_elems].out = (char *)targets[k].out + desc->value_offset +
+						     (counts[k] * desc->array.elem_size);
+				n_elems++;
+				counts[k]++;
+			}
+		}
+
+		// every array is full, same as a single target decode
+		if (n_elems == 0) {
+			break;
+		}
+
+		err = decode_multi_value(decoder, elems, n_elems);
+		if (err.err != BO_JSON_ERROR_NONE) {
+			return err;
+		}
+
+		// , or ]
+		err = lexer_next(lexer, &next);
+		if (err.err != BO_JSON_ERROR_NONE) {
+			return err;
+		}
+
+		if (next.type == BO_JSON_TOKEN_COMMA) {
+			continue;
+		} else if (next.type == BO_JSON_TOKEN_ARRAY_END) {
+			break;
+		} else {
+			return BO_JSON_ERROR(BO_JSON_ERROR_INVALID_JSON, next.start, NULL);
+		}
+	}
+
+	decoder->depth--;
+
+	for (size_t k = 0; k < n_targets; k++) {
+		*(size_t *)((char *)targets[k].out + targets[k].desc->array.count_offset) =
+			counts[k];
+	}
+
+	return BO_JSON_OK();
+}
+
+struct bo_json_error bo_json_decode_multi(const char *in, const size_t in_len,
+					  const struct bo_json_decode_target *targets,
+					  size_t n_targets)
+{
+	struct bo_json_decoder decoder = {
+		.lexer =
+			{
+				.start = in,
+				.pos = in,
+				.end = in + in_len,
+			},
+		.flags = BO_JSON_DECODE_FLAGS_NONE,
+		.depth = 0,
 	};
+	struct bo_json_decode_target used[BO_JSON_DECODE_MULTI_MAX];
+	size_t n_used = 0;
+
+	if (n_targets > BO_JSON_DECODE_MULTI_MAX) {
+		return BO_JSON_ERROR(BO_JSON_ERROR_NOT_SUPPORT, in, NULL);
+	}
+
+	for (size_t k = 0; k < n_targets; k++) {
+		if (targets[k].desc != NULL) {
+			used[n_used++] = targets[k];
+		}
+	}
 
-	struct bo_json_error err = decode_value(&lexer, obj_desc, out);
+	struct bo_json_error err = decode_multi_value(&decoder, used, n_used);
 	if (err.err != BO_JSON_ERROR_NONE) {
 		return err;
 	}
 
-	err.pos = lexer.pos;
+	err.pos = decoder.lexer.pos;
 	return err;
 }
@@ -1,9 +1,15 @@
 #include <stdbool.h>
-#include <stdio.h>
 #include <string.h>
-#include <inttypes.h>
+#include <stdint.h>
 
 #include "boring_json.h"
+#include "boring_json_buffered_writer.h"
+#include "boring_json_format.h"
+#include "boring_json_simple_writer.h"
+
+#if defined(__SSE2__) && defined(__GNUC__)
+#include <emmintrin.h>
+#endif
 
 static struct bo_json_error encode_null(const void *in, const struct bo_json_value_desc *in_desc,
 					struct bo_json_writer *writer)
@@ -21,104 +27,323 @@ static struct bo_json_error encode_bool(const void *in, const struct bo_json_val
 
 	const bool v = *((bool *)((const char *)in + in_desc->value_offset));
 	if (v) {
-		return bo_json_writer_write(writer, true_str, sizeof(true_str) - 1);
+		return bo_json_writer_write_ref(writer, true_str, sizeof(true_str) - 1);
 	} else {
-		return bo_json_writer_write(writer, false_str, sizeof(false_str) - 1);
+		return bo_json_writer_write_ref(writer, false_str, sizeof(false_str) - 1);
 	}
 }
 
-static struct bo_json_error encode_int(const void *in, const struct bo_json_value_desc *in_desc,
-				       struct bo_json_writer *writer)
+/**
+ * @brief Write an integer, formatted in place when the writer can reserve room for it
+ */
+static struct bo_json_error write_int64(struct bo_json_writer *writer, int64_t v)
 {
-	char number_str[12];
-	int len = snprintf(number_str, sizeof(number_str), "%d",
-			   *((const int *)((const char *)in + in_desc->value_offset)));
-	if (len < 0) {
-		return BO_JSON_ERROR(BO_JSON_ERROR_CONVERT, NULL, in_desc);
+	char *dest = bo_json_writer_reserve(writer, BO_JSON_INT64_STR_MAX);
+
+	if (dest != NULL) {
+		bo_json_writer_commit(writer, dest, bo_json_format_int64(dest, v));
+		return BO_JSON_OK();
 	}
+
+	char number_str[BO_JSON_INT64_STR_MAX];
+	const size_t len = bo_json_format_int64(number_str, v);
+
 	return bo_json_writer_write(writer, number_str, len);
 }
 
+static struct bo_json_error encode_int(const void *in, const struct bo_json_value_desc *in_desc,
+				       struct bo_json_writer *writer)
+{
+	return write_int64(writer, *((const int *)((const char *)in + in_desc->value_offset)));
+}
+
 static struct bo_json_error encode_int64(const void *in, const struct bo_json_value_desc *in_desc,
 					 struct bo_json_writer *writer)
 {
-	char number_str[24];
-	int len = snprintf(number_str, sizeof(number_str), "%" PRIi64,
-			   *((const int64_t *)((const char *)in + in_desc->value_offset)));
-	if (len < 0) {
-		return BO_JSON_ERROR(BO_JSON_ERROR_CONVERT, NULL, in_desc);
+	return write_int64(writer, *((const int64_t *)((const char *)in + in_desc->value_offset)));
+}
+
+/**
+ * @brief Format a finite double as its descriptor asks, fixed decimals or shortest
+ */
+static size_t format_double(char *dest, double v, const struct bo_json_value_desc *in_desc)
+{
+	if (in_desc->flags & BO_JSON_FLAGS_FIXED_DECIMALS) {
+		const size_t len = bo_json_format_fixed(dest, v, in_desc->number.decimals);
+
+		if (len > 0) {
+			return len;
+		}
 	}
-	return bo_json_writer_write(writer, number_str, len);
+
+	return bo_json_format_double(dest, v);
 }
 
 static struct bo_json_error encode_double(const void *in, const struct bo_json_value_desc *in_desc,
 					  struct bo_json_writer *writer)
 {
-	char number_str[26];
-	int len = snprintf(number_str, sizeof(number_str), "%1.15g",
-			   *((const double *)((const char *)in + in_desc->value_offset)));
-	if (len < 0) {
+	const double v = *((const double *)((const char *)in + in_desc->value_offset));
+
+	if (!bo_json_double_is_finite(v)) {
+		if (in_desc->flags & BO_JSON_FLAGS_NONFINITE_NULL) {
+			return bo_json_writer_write(writer, "null", 4);
+		}
+		if (in_desc->flags & BO_JSON_FLAGS_NONFINITE_STRING) {
+			if (v != v) {
+				return bo_json_writer_write(writer, "\"NaN\"", 5);
+			}
+			return (v > 0) ? bo_json_writer_write(writer, "\"Infinity\"", 10)
+				       : bo_json_writer_write(writer, "\"-Infinity\"", 11);
+		}
 		return BO_JSON_ERROR(BO_JSON_ERROR_CONVERT, NULL, in_desc);
 	}
+
+	char *dest = bo_json_writer_reserve(writer, BO_JSON_DOUBLE_STR_MAX);
+
+	if (dest != NULL) {
+		bo_json_writer_commit(writer, dest, format_double(dest, v, in_desc));
+		return BO_JSON_OK();
+	}
+
+	char number_str[BO_JSON_DOUBLE_STR_MAX];
+	const size_t len = format_double(number_str, v, in_desc);
+
 	return bo_json_writer_write(writer, number_str, len);
 }
 
-static struct bo_json_error encode_cstr(const void *in, const struct bo_json_value_desc *in_desc,
-					struct bo_json_writer *writer)
+#define SWAR_ONES  (UINT64_C(0x0101010101010101))
+#define SWAR_HIGHS (UINT64_C(0x8080808080808080))
+
+/**
+ * @brief Whether any byte of a word is zero
+ */
+static inline bool swar_has_zero(uint64_t w)
 {
-	struct bo_json_error err;
+	return ((w - SWAR_ONES) & ~w & SWAR_HIGHS) != 0;
+}
 
-	err = bo_json_writer_write(writer, "\"", 1);
-	if (err.err != BO_JSON_ERROR_NONE) {
-		return err;
-	}
+/**
+ * @brief Whether any byte of a word needs escaping (or is the terminator)
+ */
+static inline bool swar_has_special(uint64_t w)
+{
+	return ((w - (SWAR_ONES * 0x20)) & ~w & SWAR_HIGHS) != 0 || // < 0x20
+	       swar_has_zero(w ^ (SWAR_ONES * '"')) || swar_has_zero(w ^ (SWAR_ONES * '\\'));
+}
 
-	const char *str = (const char *)in + in_desc->value_offset;
-	const char *ptr = str;
+static inline bool is_special(char c)
+{
+	return (unsigned char)c < 0x20 || c == '"' || c == '\\';
+}
 
-	while (*ptr != '\0') {
-		const char *c = ptr;
-		ptr++;
+/**
+ * @brief Skip the bytes which are copied as is
+ *
+ * Checks 16 bytes at a time with SSE2 when available, 8 bytes at a time otherwise.
+ *
+ * @param[in] p   Start of the scan
+ * @param[in] end End of the scan
+ * @return The first byte that must be escaped or is the terminator, end if none
+ */
+static const char *skip_clean(const char *p, const char *end)
+{
+#if defined(__SSE2__) && defined(__GNUC__)
+	const __m128i quote = _mm_set1_epi8('"');
+	const __m128i backslash = _mm_set1_epi8('\\');
+	const __m128i control_max = _mm_set1_epi8(0x1F);
 
-		switch (*c) {
-		case '\"':
-			err = bo_json_writer_write(writer, "\\\"", 2);
-			break;
-		case '\\':
-			err = bo_json_writer_write(writer, "\\\\", 2);
-			break;
-		case '\b':
-			err = bo_json_writer_write(writer, "\\b", 2);
-			break;
-		case '\f':
-			err = bo_json_writer_write(writer, "\\f", 2);
-			break;
-		case '\n':
-			err = bo_json_writer_write(writer, "\\n", 2);
-			break;
-		case '\r':
-			err = bo_json_writer_write(writer, "\\r", 2);
-			break;
-		case '\t':
-			err = bo_json_writer_write(writer, "\\t", 2);
+	while (end - p >= 16) {
+		const __m128i v = _mm_loadu_si128((const __m128i *)(const void *)p);
+		const __m128i escaped =
+			_mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash));
+		const __m128i special = _mm_or_si128(
+			escaped, _mm_cmpeq_epi8(_mm_max_epu8(v, control_max), control_max));
+		const int mask = _mm_movemask_epi8(special);
+
+		if (mask != 0) {
+			return p + __builtin_ctz((unsigned int)mask);
+		}
+		p += 16;
+	}
+#endif
+
+	while (end - p >= 8) {
+		uint64_t w;
+
+		memcpy(&w, p, sizeof(w));
+		if (swar_has_special(w)) {
 			break;
-		default:
-			err = bo_json_writer_write(writer, c, 1);
+		}
+		p += 8;
+	}
+
+	while (p < end && !is_special(*p)) {
+		p++;
+	}
+
+	return p;
+}
+
+/**
+ * @brief Format the escape sequence of a character that cannot appear as is in a JSON string
+ *
+ * @param[in]  c    The character
+ * @param[out] dest The destination, at least 6 bytes
+ * @return The length of the sequence
+ */
+static size_t escape_sequence(char c, char *dest)
+{
+	static const char hex[] = "0123456789abcdef";
+	char short_escape;
+
+	switch (c) {
+	case '\"':
+		short_escape = '"';
+		break;
+	case '\\':
+		short_escape = '\\';
+		break;
+	case '\b':
+		short_escape = 'b';
+		break;
+	case '\f':
+		short_escape = 'f';
+		break;
+	case '\n':
+		short_escape = 'n';
+		break;
+	case '\r':
+		short_escape = 'r';
+		break;
+	case '\t':
+		short_escape = 't';
+		break;
+	default:
+		dest[0] = '\\';
+		dest[1] = 'u';
+		dest[2] = '0';
+		dest[3] = '0';
+		dest[4] = hex[((unsigned char)c >> 4) & 0xF];
+		dest[5] = hex[(unsigned char)c & 0xF];
+		return 6;
+	}
+
+	dest[0] = '\\';
+	dest[1] = short_escape;
+	return 2;
+}
+
+/**
+ * @brief Write the escape sequence of a character that cannot appear as is in a JSON string
+ */
+static struct bo_json_error encode_escape(char c, struct bo_json_writer *writer)
+{
+	char escape[6];
+
+	return bo_json_writer_write(writer, escape, escape_sequence(c, escape));
+}
+
+/**
+ * @brief Write the characters of [ptr, end) up to the first terminator, escaping as needed
+ */
+static struct bo_json_error encode_escaped(const char *ptr, const char *end,
+					   struct bo_json_writer *writer)
+{
+	struct bo_json_error err;
+
+	for (;;) {
+		const char *special = skip_clean(ptr, end);
+
+		// clean runs are written at once
+		if (special > ptr) {
+			err = bo_json_writer_write_ref(writer, ptr, (size_t)(special - ptr));
+			if (err.err != BO_JSON_ERROR_NONE) {
+				return err;
+			}
+		}
+
+		if (special == end || *special == '\0') {
 			break;
 		}
 
+		err = encode_escape(*special, writer);
 		if (err.err != BO_JSON_ERROR_NONE) {
 			return err;
 		}
+		ptr = special + 1;
+	}
+
+	return BO_JSON_OK();
+}
+
+static struct bo_json_error encode_cstr(const void *in, const struct bo_json_value_desc *in_desc,
+					struct bo_json_writer *writer)
+{
+	struct bo_json_error err;
+
+	err = bo_json_writer_write(writer, "\"", 1);
+	if (err.err != BO_JSON_ERROR_NONE) {
+		return err;
+	}
+
+	// never read past the storage, even if the terminator is missing
+	const char *ptr = (const char *)in + in_desc->value_offset;
+
+	err = encode_escaped(ptr, ptr + in_desc->string.capacity, writer);
+	if (err.err != BO_JSON_ERROR_NONE) {
+		return err;
 	}
 
 	return bo_json_writer_write(writer, "\"", 1);
 }
 
+/**
+ * @brief Whether the precomputed key of an attribute exists and can be written as is
+ *
+ * BO_JSON_ATTR_KEY() leaves key_len 0 for names that need escaping. The quote check rejects the
+ * spelling of a variable whose length happens to match.
+ */
+static bool key_is_clean(const struct bo_json_obj_attr_desc *desc)
+{
+	return desc->key_len != 0 && desc->key[1] == '"';
+}
+
+/**
+ * @brief Write the key of an attribute, preceded by a comma unless it is the first one
+ *
+ * The precomputed key is written at once, unless it is missing or the name needs escaping.
+ */
+static struct bo_json_error encode_key(const struct bo_json_obj_attr_desc *desc, bool first,
+				       struct bo_json_writer *writer)
+{
+	struct bo_json_error err;
+
+	if (key_is_clean(desc)) {
+		return first ? bo_json_writer_write_ref(writer, desc->key + 1, desc->key_len - 1)
+			     : bo_json_writer_write_ref(writer, desc->key, desc->key_len);
+	}
+
+	err = bo_json_writer_write(writer, first ? "\"" : ",\"", first ? 1 : 2);
+	if (err.err != BO_JSON_ERROR_NONE) {
+		return err;
+	}
+
+	err = encode_escaped(desc->name, desc->name + strlen(desc->name), writer);
+	if (err.err != BO_JSON_ERROR_NONE) {
+		return err;
+	}
+
+	return bo_json_writer_write(writer, "\":", 2);
+}
+
 static struct bo_json_error encode_value(const void *in, const struct bo_json_value_desc *in_desc,
+					 const struct bo_json_projection *proj,
+					 struct bo_json_cache *cache,
 					 struct bo_json_writer *writer);
 
 static struct bo_json_error encode_object(const void *in, const struct bo_json_value_desc *in_desc,
+					  const struct bo_json_projection *proj,
+					  struct bo_json_cache *cache,
 					  struct bo_json_writer *writer)
 {
 	struct bo_json_error err;
@@ -131,39 +356,22 @@ static struct bo_json_error encode_object(const void *in, const struct bo_json_v
 	for (size_t i = 0; i < in_desc->object.n_attr_descs; i++) {
 		const struct bo_json_obj_attr_desc *desc = &in_desc->object.attr_descs[i];
 
-		if (!(*(const bool *)((const char *)in + in_desc->value_offset +
-				      desc->exist_offset))) {
+		if (!bo_json_projection_selects(proj, i)) {
 			continue;
 		}
 
-		if (count > 0) {
-			err = bo_json_writer_write(writer, ",", 1);
-			if (err.err != BO_JSON_ERROR_NONE) {
-				return err;
-			}
-		}
-
-		err = bo_json_writer_write(writer, "\"", 1);
-		if (err.err != BO_JSON_ERROR_NONE) {
-			return err;
-		}
-
-		err = bo_json_writer_write(writer, desc->name, strlen(desc->name));
-		if (err.err != BO_JSON_ERROR_NONE) {
-			return err;
-		}
-
-		err = bo_json_writer_write(writer, "\"", 1);
-		if (err.err != BO_JSON_ERROR_NONE) {
-			return err;
+		if (!(*(const bool *)((const char *)in + in_desc->value_offset +
+				      desc->exist_offset))) {
+			continue;
 		}
 
-		err = bo_json_writer_write(writer, ":", 1);
+		err = encode_key(desc, count == 0, writer);
 		if (err.err != BO_JSON_ERROR_NONE) {
 			return err;
 		}
 
-		err = encode_value((const char *)in + in_desc->value_offset, &desc->desc, writer);
+		err = encode_value((const char *)in + in_desc->value_offset, &desc->desc,
+				   bo_json_projection_attr(proj, i), cache, writer);
 		if (err.err != BO_JSON_ERROR_NONE) {
 			return err;
 		}
@@ -180,7 +388,8 @@ static struct bo_json_error encode_object(const void *in, const struct bo_json_v
 }
 
 static struct bo_json_error encode_array(const void *in, const struct bo_json_value_desc *in_desc,
-					 struct bo_json_writer *writer)
+					 const struct bo_json_projection *proj,
+					 struct bo_json_cache *cache, struct bo_json_writer *writer)
 {
 	struct bo_json_error err;
 	err = bo_json_writer_write(writer, "[", 1);
@@ -194,7 +403,8 @@ static struct bo_json_error encode_array(const void *in, const struct bo_json_va
 	const void *array_base = (const char *)in + in_desc->value_offset;
 
 	for (size_t i = 0; i < count; i++) {
-		err = encode_value((const char *)array_base + (i * elem_size), elem_desc, writer);
+		err = encode_value((const char *)array_base + (i * elem_size), elem_desc, proj,
+				   cache, writer);
 		if (err.err != BO_JSON_ERROR_NONE) {
 			return err;
 		}
@@ -215,8 +425,194 @@ static struct bo_json_error encode_array(const void *in, const struct bo_json_va
 	return BO_JSON_OK();
 }
 
+static struct bo_json_error encode_generated(const void *in,
+					     const struct bo_json_value_desc *in_desc,
+					     const struct bo_json_projection *proj,
+					     struct bo_json_writer *writer)
+{
+	void *ctx = *(void *const *)((const char *)in + in_desc->generator.ctx_offset);
+	// the element storage belongs to the value, it is only filled by the callback
+	void *elem = (char *)in + in_desc->value_offset;
+	const struct bo_json_value_desc *elem_desc = in_desc->generator.elem_attr_desc;
+	struct bo_json_error err;
+
+	for (size_t i = 0;; i++) {
+		const int ret = in_desc->generator.next(ctx, elem);
+
+		if (ret < 0) {
+			return BO_JSON_ERROR(BO_JSON_ERROR_IO, NULL, in_desc);
+		}
+		if (ret == 0) {
+			break;
+		}
+
+		if (i > 0) {
+			err = bo_json_writer_write(writer, ",", 1);
+			if (err.err != BO_JSON_ERROR_NONE) {
+				return err;
+			}
+		}
+
+		err = encode_value(elem, elem_desc, proj, NULL, writer);
+		if (err.err != BO_JSON_ERROR_NONE) {
+			return err;
+		}
+	}
+
+	return BO_JSON_OK();
+}
+
+/**
+ * @brief Encode the elements of a generator as an array
+ *
+ * The next element overwrites the storage of the previous one, so nothing may keep pointing to it:
+ * the elements go through `write` instead of `write_ref`, and bypass the cache, which finds
+ * objects by their address.
+ */
+static struct bo_json_error encode_generator(const void *in,
+					     const struct bo_json_value_desc *in_desc,
+					     const struct bo_json_projection *proj,
+					     struct bo_json_writer *writer)
+{
+	struct bo_json_error (*write_ref)(struct bo_json_writer *writer, const void *data,
+					  size_t len) = writer->write_ref;
+	struct bo_json_error err;
+
+	err = bo_json_writer_write(writer, "[", 1);
+	if (err.err != BO_JSON_ERROR_NONE) {
+		return err;
+	}
+
+	writer->write_ref = NULL;
+	err = encode_generated(in, in_desc, proj, writer);
+	writer->write_ref = write_ref;
+	if (err.err != BO_JSON_ERROR_NONE) {
+		return err;
+	}
+
+	return bo_json_writer_write(writer, "]", 1);
+}
+
+// the entry of an object, whatever its generation
+static struct bo_json_cache_entry *cache_find(struct bo_json_cache *cache, const void *in,
+					      const struct bo_json_value_desc *in_desc)
+{
+	for (size_t i = 0; i < cache->n_used; i++) {
+		struct bo_json_cache_entry *entry = &cache->entries[i];
+
+		if (entry->in == in && entry->desc == in_desc) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Encode an object into the memory of its entry, the last entry may grow into what is left
+ */
+static struct bo_json_error cache_encode(struct bo_json_cache *cache,
+					 struct bo_json_cache_entry *entry, const void *in,
+					 const struct bo_json_value_desc *in_desc)
+{
+	const bool last = entry->offset + entry->cap == cache->used;
+	struct bo_json_simple_writer fill;
+	struct bo_json_error err;
+
+	// nested cached objects are part of this entry, not entries of their own
+	bo_json_simple_writer_init(&fill, cache->buf + entry->offset,
+				   last ? cache->cap - entry->offset : entry->cap);
+	err = encode_object(in, in_desc, NULL, NULL, &fill.ctx);
+	if (err.err != BO_JSON_ERROR_NONE) {
+		return err;
+	}
+
+	entry->len = fill.len;
+	if (last) {
+		entry->cap = fill.len;
+		cache->used = entry->offset + fill.len;
+	}
+
+	return BO_JSON_OK();
+}
+
+/**
+ * @brief Bring an entry to the current generation
+ *
+ * An object which no longer fits in its memory moves to what is left of the cache memory, its old
+ * bytes stay unused. An object which fits nowhere is marked too large for this generation.
+ */
+static struct bo_json_error cache_fill(struct bo_json_cache *cache,
+				       struct bo_json_cache_entry *entry, const void *in,
+				       const struct bo_json_value_desc *in_desc)
+{
+	struct bo_json_error err;
+
+	err = cache_encode(cache, entry, in, in_desc);
+	if (err.err == BO_JSON_ERROR_INSUFFICIENT_SPACE &&
+	    entry->offset + entry->cap != cache->used) {
+		entry->offset = cache->used;
+		entry->cap = 0;
+		err = cache_encode(cache, entry, in, in_desc);
+	}
+	if (err.err != BO_JSON_ERROR_NONE && err.err != BO_JSON_ERROR_INSUFFICIENT_SPACE) {
+		return err;
+	}
+
+	entry->generation = cache->generation;
+	entry->too_large = err.err == BO_JSON_ERROR_INSUFFICIENT_SPACE;
+
+	return BO_JSON_OK();
+}
+
+/**
+ * @brief Write an object from the cache, encoding it into the cache first if it is missing
+ *
+ * Objects that do not fit in the cache are encoded directly, and only tried again in the next
+ * generation.
+ */
+static struct bo_json_error encode_object_cached(const void *in,
+						 const struct bo_json_value_desc *in_desc,
+						 struct bo_json_cache *cache,
+						 struct bo_json_writer *writer)
+{
+	const void *object = (const char *)in + in_desc->value_offset;
+	struct bo_json_cache_entry *entry = cache_find(cache, object, in_desc);
+	struct bo_json_error err;
+
+	if (entry == NULL) {
+		if (cache->n_used == cache->n_entries) {
+			return encode_object(in, in_desc, NULL, NULL, writer);
+		}
+
+		// only taken once filled
+		entry = &cache->entries[cache->n_used];
+		entry->in = object;
+		entry->desc = in_desc;
+		entry->offset = cache->used;
+		entry->cap = 0;
+		err = cache_fill(cache, entry, in, in_desc);
+		if (err.err != BO_JSON_ERROR_NONE) {
+			return err;
+		}
+		cache->n_used++;
+	} else if (entry->generation != cache->generation) {
+		err = cache_fill(cache, entry, in, in_desc);
+		if (err.err != BO_JSON_ERROR_NONE) {
+			return err;
+		}
+	}
+
+	if (entry->too_large) {
+		return encode_object(in, in_desc, NULL, NULL, writer);
+	}
+
+	return bo_json_writer_write(writer, cache->buf + entry->offset, entry->len);
+}
+
 static struct bo_json_error encode_value(const void *in, const struct bo_json_value_desc *in_desc,
-					 struct bo_json_writer *writer)
+					 const struct bo_json_projection *proj,
+					 struct bo_json_cache *cache, struct bo_json_writer *writer)
 {
 	switch (in_desc->type) {
 	case BO_JSON_VALUE_TYPE_NULL:
@@ -232,9 +628,15 @@ static struct bo_json_error encode_value(const void *in, const struct bo_json_va
 	case BO_JSON_VALUE_TYPE_CSTR:
 		return encode_cstr(in, in_desc, writer);
 	case BO_JSON_VALUE_TYPE_OBJECT:
-		return encode_object(in, in_desc, writer);
+		// the cached bytes hold every attribute
+		if (cache != NULL && proj == NULL && (in_desc->flags & BO_JSON_FLAGS_CACHED)) {
+			return encode_object_cached(in, in_desc, cache, writer);
+		}
+		return encode_object(in, in_desc, proj, cache, writer);
 	case BO_JSON_VALUE_TYPE_ARRAY:
-		return encode_array(in, in_desc, writer);
+		return encode_array(in, in_desc, proj, cache, writer);
+	case BO_JSON_VALUE_TYPE_GENERATOR:
+		return encode_generator(in, in_desc, proj, writer);
 	default:
 		return BO_JSON_ERROR(BO_JSON_ERROR_NOT_SUPPORT, NULL, in_desc);
 	}
@@ -245,5 +647,790 @@ static struct bo_json_error encode_value(const void *in, const struct bo_json_va
 struct bo_json_error bo_json_encode(const void *in, const struct bo_json_value_desc *in_desc,
 				    struct bo_json_writer *writer)
 {
-	return encode_value(in, in_desc, writer);
+	return encode_value(in, in_desc, NULL, NULL, writer);
+}
+
+struct bo_json_error bo_json_encode_ex(const void *in, const struct bo_json_value_desc *in_desc,
+				       const struct bo_json_projection *proj,
+				       struct bo_json_writer *writer)
+{
+	return encode_value(in, in_desc, proj, NULL, writer);
+}
+
+static struct bo_json_error encode_lines(const char *array, size_t elem_size, size_t count,
+					 const struct bo_json_value_desc *elem_desc,
+					 struct bo_json_writer *writer)
+{
+	struct bo_json_error err;
+
+	for (size_t i = 0; i < count; i++) {
+		err = encode_value(array + (i * elem_size), elem_desc, NULL, NULL, writer);
+		if (err.err != BO_JSON_ERROR_NONE) {
+			return err;
+		}
+
+		err = bo_json_writer_write(writer, "\n", 1);
+		if (err.err != BO_JSON_ERROR_NONE) {
+			return err;
+		}
+	}
+
+	return BO_JSON_OK();
+}
+
+// kept apart so that the block is only on the stack when it is used
+static struct bo_json_error encode_lines_blocked(const char *array, size_t elem_size,
+						 size_t count,
+						 const struct bo_json_value_desc *elem_desc,
+						 struct bo_json_writer *writer)
+{
+	char block[BO_JSON_NDJSON_BLOCK_SIZE];
+	struct bo_json_buffered_writer buffered;
+	struct bo_json_error err, flush_err;
+
+	bo_json_buffered_writer_init(&buffered, writer, block, sizeof(block));
+
+	// flushed on error too, so the writer gets the same output as without the block
+	err = encode_lines(array, elem_size, count, elem_desc, &buffered.ctx);
+	flush_err = bo_json_buffered_writer_flush(&buffered);
+
+	return err.err != BO_JSON_ERROR_NONE ? err : flush_err;
+}
+
+struct bo_json_error bo_json_encode_ndjson(const void *array, size_t elem_size, size_t count,
+					   const struct bo_json_value_desc *elem_desc,
+					   struct bo_json_writer *writer)
+{
+	// a window is already a buffer, another copy would only slow it down
+	if (bo_json_writer_has_window(writer)) {
+		return encode_lines(array, elem_size, count, elem_desc, writer);
+	}
+
+	return encode_lines_blocked(array, elem_size, count, elem_desc, writer);
+}
+
+static bool attr_exists(const void *in, const struct bo_json_value_desc *in_desc,
+			const struct bo_json_obj_attr_desc *desc)
+{
+	return *(const bool *)((const char *)in + in_desc->value_offset + desc->exist_offset);
+}
+
+static bool value_equal(const void *a, const void *b, const struct bo_json_value_desc *desc)
+{
+	const char *va = (const char *)a + desc->value_offset;
+	const char *vb = (const char *)b + desc->value_offset;
+
+	switch (desc->type) {
+	case BO_JSON_VALUE_TYPE_BOOL:
+		return *(const bool *)va == *(const bool *)vb;
+	case BO_JSON_VALUE_TYPE_INT:
+		return *(const int *)va == *(const int *)vb;
+	case BO_JSON_VALUE_TYPE_INT64:
+		return *(const int64_t *)va == *(const int64_t *)vb;
+	case BO_JSON_VALUE_TYPE_DOUBLE:
+		// bit for bit, so that a NaN which stays NaN is unchanged
+		return memcmp(va, vb, sizeof(double)) == 0;
+	case BO_JSON_VALUE_TYPE_CSTR:
+		return strncmp(va, vb, desc->string.capacity) == 0;
+	case BO_JSON_VALUE_TYPE_OBJECT:
+		for (size_t i = 0; i < desc->object.n_attr_descs; i++) {
+			const struct bo_json_obj_attr_desc *attr = &desc->object.attr_descs[i];
+			const bool exists = attr_exists(a, desc, attr);
+
+			if (exists != attr_exists(b, desc, attr)) {
+				return false;
+			}
+			if (exists && !value_equal(va, vb, &attr->desc)) {
+				return false;
+			}
+		}
+		return true;
+	case BO_JSON_VALUE_TYPE_GENERATOR:
+		// the elements cannot be produced twice, so they are always written
+		return false;
+	case BO_JSON_VALUE_TYPE_ARRAY: {
+		const size_t count = *(const size_t *)((const char *)a + desc->array.count_offset);
+		const size_t elem_size = desc->array.elem_size;
+
+		if (count != *(const size_t *)((const char *)b + desc->array.count_offset)) {
+			return false;
+		}
+		for (size_t i = 0; i < count; i++) {
+			if (!value_equal(va + (i * elem_size), vb + (i * elem_size),
+					 desc->array.elem_attr_desc)) {
+				return false;
+			}
+		}
+		return true;
+	}
+	default:
+		return true;
+	}
+}
+
+static struct bo_json_error encode_object_delta(const void *in, const void *prev,
+						const struct bo_json_value_desc *in_desc,
+						struct bo_json_writer *writer)
+{
+	const char *base = (const char *)in + in_desc->value_offset;
+	const char *prev_base = (const char *)prev + in_desc->value_offset;
+	struct bo_json_error err;
+
+	err = bo_json_writer_write(writer, "{", 1);
+	if (err.err != BO_JSON_ERROR_NONE) {
+		return err;
+	}
+
+	size_t count = 0;
+	for (size_t i = 0; i < in_desc->object.n_attr_descs; i++) {
+		const struct bo_json_obj_attr_desc *desc = &in_desc->object.attr_descs[i];
+		const bool exists = attr_exists(in, in_desc, desc);
+		const bool existed = attr_exists(prev, in_desc, desc);
+
+		if (exists && existed && value_equal(base, prev_base, &desc->desc)) {
+			continue;
+		}
+		if (!exists && !existed) {
+			continue;
+		}
+
+		err = encode_key(desc, count == 0, writer);
+		if (err.err != BO_JSON_ERROR_NONE) {
+			return err;
+		}
+
+		if (!exists) {
+			err = bo_json_writer_write(writer, "null", 4);
+		} else if (existed && desc->desc.type == BO_JSON_VALUE_TYPE_OBJECT) {
+			err = encode_object_delta(base, prev_base, &desc->desc, writer);
+		} else {
+			err = encode_value(base, &desc->desc, NULL, NULL, writer);
+		}
+		if (err.err != BO_JSON_ERROR_NONE) {
+			return err;
+		}
+
+		count++;
+	}
+
+	return bo_json_writer_write(writer, "}", 1);
+}
+
+void bo_json_cache_init(struct bo_json_cache *cache, struct bo_json_cache_entry *entries,
+			size_t n_entries, char *buf, size_t cap)
+{
+	cache->entries = entries;
+	cache->n_entries = n_entries;
+	cache->buf = buf;
+	cache->cap = cap;
+	cache->generation = 0;
+	cache->n_used = 0;
+	cache->used = 0;
+}
+
+void bo_json_cache_bump(struct bo_json_cache *cache)
+{
+	cache->generation++;
+}
+
+struct bo_json_error bo_json_encode_cached(const void *in, const struct bo_json_value_desc *in_desc,
+					   struct bo_json_cache *cache,
+					   struct bo_json_writer *writer)
+{
+	return encode_value(in, in_desc, NULL, cache, writer);
+}
+
+static struct bo_json_error template_add_hole(struct bo_json_template *tmpl, size_t holes_cap,
+					      const struct bo_json_value_desc *desc, size_t offset,
+					      struct bo_json_simple_writer *literals)
+{
+	if (tmpl->n_holes == holes_cap) {
+		return BO_JSON_ERROR(BO_JSON_ERROR_INSUFFICIENT_SPACE, NULL, desc);
+	}
+
+	struct bo_json_template_hole *hole = &tmpl->holes[tmpl->n_holes++];
+
+	hole->desc = desc;
+	hole->offset = offset;
+	hole->literal_offset = tmpl->tail_offset;
+	hole->literal_len = literals->len - tmpl->tail_offset;
+	tmpl->tail_offset = literals->len;
+	return BO_JSON_OK();
+}
+
+/**
+ * @brief Add the literal text and the holes of a value read at offset
+ */
+static struct bo_json_error template_add(struct bo_json_template *tmpl, size_t holes_cap,
+					 const struct bo_json_value_desc *desc, size_t offset,
+					 struct bo_json_simple_writer *literals)
+{
+	struct bo_json_error err;
+
+	if (desc->type != BO_JSON_VALUE_TYPE_OBJECT) {
+		return template_add_hole(tmpl, holes_cap, desc, offset, literals);
+	}
+
+	err = bo_json_writer_write(&literals->ctx, "{", 1);
+	if (err.err != BO_JSON_ERROR_NONE) {
+		return err;
+	}
+
+	for (size_t i = 0; i < desc->object.n_attr_descs; i++) {
+		const struct bo_json_obj_attr_desc *attr = &desc->object.attr_descs[i];
+
+		err = encode_key(attr, i == 0, &literals->ctx);
+		if (err.err != BO_JSON_ERROR_NONE) {
+			return err;
+		}
+
+		err = template_add(tmpl, holes_cap, &attr->desc, offset + desc->value_offset,
+				   literals);
+		if (err.err != BO_JSON_ERROR_NONE) {
+			return err;
+		}
+	}
+
+	return bo_json_writer_write(&literals->ctx, "}", 1);
+}
+
+struct bo_json_error bo_json_template_build(struct bo_json_template *tmpl,
+					    const struct bo_json_value_desc *desc,
+					    struct bo_json_template_hole *holes, size_t holes_cap,
+					    char *literals, size_t literals_cap)
+{
+	struct bo_json_simple_writer writer;
+	struct bo_json_error err;
+
+	tmpl->holes = holes;
+	tmpl->n_holes = 0;
+	tmpl->literals = literals;
+	tmpl->tail_offset = 0;
+
+	bo_json_simple_writer_init(&writer, literals, literals_cap);
+	err = template_add(tmpl, holes_cap, desc, 0, &writer);
+	if (err.err != BO_JSON_ERROR_NONE) {
+		return err;
+	}
+
+	tmpl->tail_len = writer.len - tmpl->tail_offset;
+	return BO_JSON_OK();
+}
+
+struct bo_json_error bo_json_template_encode(const struct bo_json_template *tmpl, const void *in,
+					     struct bo_json_writer *writer)
+{
+	struct bo_json_error err;
+
+	for (size_t i = 0; i < tmpl->n_holes; i++) {
+		const struct bo_json_template_hole *hole = &tmpl->holes[i];
+
+		err = bo_json_writer_write(writer, tmpl->literals + hole->literal_offset,
+					   hole->literal_len);
+		if (err.err != BO_JSON_ERROR_NONE) {
+			return err;
+		}
+
+		err = encode_value((const char *)in + hole->offset, hole->desc, NULL, NULL, writer);
+		if (err.err != BO_JSON_ERROR_NONE) {
+			return err;
+		}
+	}
+
+	return bo_json_writer_write(writer, tmpl->literals + tmpl->tail_offset, tmpl->tail_len);
+}
+
+struct bo_json_error bo_json_encode_delta(const void *in, const void *prev,
+					  const struct bo_json_value_desc *in_desc,
+					  struct bo_json_writer *writer)
+{
+	if (in_desc->type != BO_JSON_VALUE_TYPE_OBJECT) {
+		return encode_value(in, in_desc, NULL, NULL, writer);
+	}
+
+	return encode_object_delta(in, prev, in_desc, writer);
+}
+
+/**
+ * @brief The length encode_escape() writes for a character
+ */
+static size_t escape_len(char c)
+{
+	switch (c) {
+	case '\"':
+	case '\\':
+	case '\b':
+	case '\f':
+	case '\n':
+	case '\r':
+	case '\t':
+		return 2;
+	default:
+		return 6;
+	}
+}
+
+/**
+ * @brief The length encode_escaped() writes for [ptr, end)
+ */
+static size_t escaped_len(const char *ptr, const char *end)
+{
+	size_t len = 0;
+
+	for (;;) {
+		const char *special = skip_clean(ptr, end);
+
+		len += (size_t)(special - ptr);
+		if (special == end || *special == '\0') {
+			return len;
+		}
+
+		len += escape_len(*special);
+		ptr = special + 1;
+	}
+}
+
+static struct bo_json_error value_size(const void *in, const struct bo_json_value_desc *in_desc,
+				       size_t *size);
+
+static struct bo_json_error double_size(const void *in, const struct bo_json_value_desc *in_desc,
+					size_t *size)
+{
+	const double v = *((const double *)((const char *)in + in_desc->value_offset));
+
+	size_t len = 0;
+
+	if (bo_json_double_is_finite(v)) {
+		if (in_desc->flags & BO_JSON_FLAGS_FIXED_DECIMALS) {
+			len = bo_json_fixed_len(v, in_desc->number.decimals);
+		}
+		*size += (len > 0) ? len : bo_json_double_len(v);
+	} else if (in_desc->flags & BO_JSON_FLAGS_NONFINITE_NULL) {
+		*size += 4;
+	} else if (in_desc->flags & BO_JSON_FLAGS_NONFINITE_STRING) {
+		*size += (v != v) ? 5 : (v > 0) ? 10 : 11;
+	} else {
+		return BO_JSON_ERROR(BO_JSON_ERROR_CONVERT, NULL, in_desc);
+	}
+
+	return BO_JSON_OK();
+}
+
+static struct bo_json_error object_size(const void *in, const struct bo_json_value_desc *in_desc,
+					size_t *size)
+{
+	struct bo_json_error err;
+	size_t count = 0;
+
+	// {}
+	*size += 2;
+
+	for (size_t i = 0; i < in_desc->object.n_attr_descs; i++) {
+		const struct bo_json_obj_attr_desc *desc = &in_desc->object.attr_descs[i];
+
+		if (!(*(const bool *)((const char *)in + in_desc->value_offset +
+				      desc->exist_offset))) {
+			continue;
+		}
+
+		// the same choice as encode_key()
+		if (key_is_clean(desc)) {
+			*size += desc->key_len - 1;
+		} else {
+			*size += 3 + escaped_len(desc->name, desc->name + strlen(desc->name));
+		}
+
+		if (count > 0) {
+			*size += 1;
+		}
+
+		err = value_size((const char *)in + in_desc->value_offset, &desc->desc, size);
+		if (err.err != BO_JSON_ERROR_NONE) {
+			return err;
+		}
+
+		count++;
+	}
+
+	return BO_JSON_OK();
+}
+
+static struct bo_json_error array_size(const void *in, const struct bo_json_value_desc *in_desc,
+				       size_t *size)
+{
+	struct bo_json_error err;
+
+	const size_t count = *((size_t *)((const char *)in + in_desc->array.count_offset));
+	const struct bo_json_value_desc *elem_desc = in_desc->array.elem_attr_desc;
+	const size_t elem_size = in_desc->array.elem_size;
+	const void *array_base = (const char *)in + in_desc->value_offset;
+
+	// [] and the commas between the elements
+	*size += 2 + ((count > 0) ? count - 1 : 0);
+
+	for (size_t i = 0; i < count; i++) {
+		err = value_size((const char *)array_base + (i * elem_size), elem_desc, size);
+		if (err.err != BO_JSON_ERROR_NONE) {
+			return err;
+		}
+	}
+
+	return BO_JSON_OK();
+}
+
+static struct bo_json_error value_size(const void *in, const struct bo_json_value_desc *in_desc,
+				       size_t *size)
+{
+	const char *value = (const char *)in + in_desc->value_offset;
+
+	switch (in_desc->type) {
+	case BO_JSON_VALUE_TYPE_BOOL:
+		*size += *((const bool *)value) ? 4 : 5;
+		return BO_JSON_OK();
+	case BO_JSON_VALUE_TYPE_INT:
+		*size += bo_json_int64_len(*((const int *)value));
+		return BO_JSON_OK();
+	case BO_JSON_VALUE_TYPE_INT64:
+		*size += bo_json_int64_len(*((const int64_t *)value));
+		return BO_JSON_OK();
+	case BO_JSON_VALUE_TYPE_DOUBLE:
+		return double_size(in, in_desc, size);
+	case BO_JSON_VALUE_TYPE_CSTR:
+		*size += 2 + escaped_len(value, value + in_desc->string.capacity);
+		return BO_JSON_OK();
+	case BO_JSON_VALUE_TYPE_OBJECT:
+		return object_size(in, in_desc, size);
+	case BO_JSON_VALUE_TYPE_ARRAY:
+		return array_size(in, in_desc, size);
+	default:
+		return BO_JSON_ERROR(BO_JSON_ERROR_NOT_SUPPORT, NULL, in_desc);
+	}
+}
+
+struct bo_json_error bo_json_encoded_size(const void *in, const struct bo_json_value_desc *in_desc,
+					  size_t *size)
+{
+	struct bo_json_error err;
+	size_t total = 0;
+
+	err = value_size(in, in_desc, &total);
+	if (err.err != BO_JSON_ERROR_NONE) {
+		return err;
+	}
+
+	*size = total;
+	return BO_JSON_OK();
+}
+
+static struct bo_json_error value_max_size(const struct bo_json_value_desc *in_desc, size_t *size);
+
+static struct bo_json_error object_max_size(const struct bo_json_value_desc *in_desc,
+					    size_t *size)
+{
+	struct bo_json_error err;
+
+	// {} and the commas between the attributes
+	*size += 2 + ((in_desc->object.n_attr_descs > 0) ? in_desc->object.n_attr_descs - 1 : 0);
+
+	for (size_t i = 0; i < in_desc->object.n_attr_descs; i++) {
+		const struct bo_json_obj_attr_desc *desc = &in_desc->object.attr_descs[i];
+
+		if (key_is_clean(desc)) {
+			*size += desc->key_len - 1;
+		} else {
+			*size += 3 + escaped_len(desc->name, desc->name + strlen(desc->name));
+		}
+
+		err = value_max_size(&desc->desc, size);
+		if (err.err != BO_JSON_ERROR_NONE) {
+			return err;
+		}
+	}
+
+	return BO_JSON_OK();
+}
+
+static struct bo_json_error value_max_size(const struct bo_json_value_desc *in_desc, size_t *size)
+{
+	struct bo_json_error err;
+	size_t elem_max = 0;
+
+	switch (in_desc->type) {
+	case BO_JSON_VALUE_TYPE_BOOL:
+		*size += BO_JSON_MAX_SIZE_BOOL;
+		return BO_JSON_OK();
+	case BO_JSON_VALUE_TYPE_INT:
+		*size += BO_JSON_MAX_SIZE_INT;
+		return BO_JSON_OK();
+	case BO_JSON_VALUE_TYPE_INT64:
+		*size += BO_JSON_MAX_SIZE_INT64;
+		return BO_JSON_OK();
+	case BO_JSON_VALUE_TYPE_DOUBLE:
+		*size += BO_JSON_MAX_SIZE_DOUBLE;
+		return BO_JSON_OK();
+	case BO_JSON_VALUE_TYPE_CSTR:
+		*size += BO_JSON_MAX_SIZE_CSTR(in_desc->string.capacity);
+		return BO_JSON_OK();
+	case BO_JSON_VALUE_TYPE_OBJECT:
+		return object_max_size(in_desc, size);
+	case BO_JSON_VALUE_TYPE_ARRAY:
+		err = value_max_size(in_desc->array.elem_attr_desc, &elem_max);
+		if (err.err != BO_JSON_ERROR_NONE) {
+			return err;
+		}
+		*size += BO_JSON_MAX_SIZE_ARRAY(in_desc->array.capacity, elem_max);
+		return BO_JSON_OK();
+	default:
+		return BO_JSON_ERROR(BO_JSON_ERROR_NOT_SUPPORT, NULL, in_desc);
+	}
+}
+
+struct bo_json_error bo_json_max_encoded_size(const struct bo_json_value_desc *in_desc,
+					      size_t *size)
+{
+	struct bo_json_error err;
+	size_t total = 0;
+
+	err = value_max_size(in_desc, &total);
+	if (err.err != BO_JSON_ERROR_NONE) {
+		return err;
+	}
+
+	*size = total;
+	return BO_JSON_OK();
+}
+
+static void step_set_piece(struct bo_json_encoder *encoder, const char *piece, size_t len)
+{
+	encoder->piece = piece;
+	encoder->piece_len = len;
+}
+
+/**
+ * @brief Start a value: set its first piece, and enter it if it is an object or an array
+ */
+static struct bo_json_error step_begin_value(struct bo_json_encoder *encoder, const void *in,
+					     const struct bo_json_value_desc *in_desc)
+{
+	const char *value = (const char *)in + in_desc->value_offset;
+	struct bo_json_encoder_frame *frame;
+
+	switch (in_desc->type) {
+	case BO_JSON_VALUE_TYPE_BOOL:
+		if (*(const bool *)value) {
+			step_set_piece(encoder, "true", 4);
+		} else {
+			step_set_piece(encoder, "false", 5);
+		}
+		return BO_JSON_OK();
+	case BO_JSON_VALUE_TYPE_INT:
+		step_set_piece(encoder, encoder->scratch,
+			       bo_json_format_int64(encoder->scratch, *(const int *)value));
+		return BO_JSON_OK();
+	case BO_JSON_VALUE_TYPE_INT64:
+		step_set_piece(encoder, encoder->scratch,
+			       bo_json_format_int64(encoder->scratch, *(const int64_t *)value));
+		return BO_JSON_OK();
+	case BO_JSON_VALUE_TYPE_DOUBLE: {
+		const double v = *(const double *)value;
+
+		if (bo_json_double_is_finite(v)) {
+			step_set_piece(encoder, encoder->scratch,
+				       format_double(encoder->scratch, v, in_desc));
+		} else if (in_desc->flags & BO_JSON_FLAGS_NONFINITE_NULL) {
+			step_set_piece(encoder, "null", 4);
+		} else if (in_desc->flags & BO_JSON_FLAGS_NONFINITE_STRING) {
+			if (v != v) {
+				step_set_piece(encoder, "\"NaN\"", 5);
+			} else if (v > 0) {
+				step_set_piece(encoder, "\"Infinity\"", 10);
+			} else {
+				step_set_piece(encoder, "\"-Infinity\"", 11);
+			}
+		} else {
+			return BO_JSON_ERROR(BO_JSON_ERROR_CONVERT, NULL, in_desc);
+		}
+		return BO_JSON_OK();
+	}
+	case BO_JSON_VALUE_TYPE_CSTR:
+		encoder->str = value;
+		encoder->str_end = value + in_desc->string.capacity;
+		encoder->str_close = "\"";
+		step_set_piece(encoder, "\"", 1);
+		return BO_JSON_OK();
+	case BO_JSON_VALUE_TYPE_OBJECT:
+	case BO_JSON_VALUE_TYPE_ARRAY:
+		if (encoder->depth == BO_JSON_ENCODER_MAX_DEPTH) {
+			return BO_JSON_ERROR(BO_JSON_ERROR_OVERFLOW, NULL, in_desc);
+		}
+
+		frame = &encoder->stack[encoder->depth++];
+		frame->desc = in_desc;
+		frame->base = value;
+		frame->index = 0;
+		frame->value_next = false;
+
+		if (in_desc->type == BO_JSON_VALUE_TYPE_OBJECT) {
+			frame->count = 0;
+			step_set_piece(encoder, "{", 1);
+		} else {
+			const char *count = (const char *)in + in_desc->array.count_offset;
+
+			frame->count = *(const size_t *)count;
+			step_set_piece(encoder, "[", 1);
+		}
+		return BO_JSON_OK();
+	default:
+		return BO_JSON_ERROR(BO_JSON_ERROR_NOT_SUPPORT, NULL, in_desc);
+	}
+}
+
+/**
+ * @brief Find the next piece of the output, the piece is NULL once the value is complete
+ */
+static struct bo_json_error step_next(struct bo_json_encoder *encoder)
+{
+	for (;;) {
+		if (encoder->str != NULL) {
+			const char *str = encoder->str;
+
+			if (str == encoder->str_end || *str == '\0') {
+				const char *close = encoder->str_close;
+
+				step_set_piece(encoder, close, strlen(close));
+				encoder->str = NULL;
+				return BO_JSON_OK();
+			}
+
+			const char *special = skip_clean(str, encoder->str_end);
+
+			if (special > str) {
+				step_set_piece(encoder, str, (size_t)(special - str));
+				encoder->str = special;
+			} else {
+				step_set_piece(encoder, encoder->scratch,
+					       escape_sequence(*str, encoder->scratch));
+				encoder->str = str + 1;
+			}
+			return BO_JSON_OK();
+		}
+
+		if (!encoder->started) {
+			encoder->started = true;
+			return step_begin_value(encoder, encoder->in, encoder->in_desc);
+		}
+
+		if (encoder->depth == 0) {
+			step_set_piece(encoder, NULL, 0);
+			return BO_JSON_OK();
+		}
+
+		struct bo_json_encoder_frame *frame = &encoder->stack[encoder->depth - 1];
+		const struct bo_json_value_desc *desc = frame->desc;
+
+		if (desc->type == BO_JSON_VALUE_TYPE_OBJECT) {
+			const struct bo_json_obj_attr_desc *attrs = desc->object.attr_descs;
+
+			if (frame->value_next) {
+				frame->value_next = false;
+				frame->count++;
+				return step_begin_value(encoder, frame->base,
+							&attrs[frame->index++].desc);
+			}
+
+			while (frame->index < desc->object.n_attr_descs &&
+			       !*(const bool *)(frame->base + attrs[frame->index].exist_offset)) {
+				frame->index++;
+			}
+
+			if (frame->index == desc->object.n_attr_descs) {
+				encoder->depth--;
+				step_set_piece(encoder, "}", 1);
+				return BO_JSON_OK();
+			}
+
+			const struct bo_json_obj_attr_desc *attr = &attrs[frame->index];
+			const bool first = frame->count == 0;
+
+			frame->value_next = true;
+			if (key_is_clean(attr)) {
+				step_set_piece(encoder, first ? attr->key + 1 : attr->key,
+					       first ? attr->key_len - 1 : attr->key_len);
+			} else {
+				step_set_piece(encoder, first ? "\"" : ",\"", first ? 1 : 2);
+				encoder->str = attr->name;
+				encoder->str_end = attr->name + strlen(attr->name);
+				encoder->str_close = "\":";
+			}
+			return BO_JSON_OK();
+		}
+
+		if (frame->value_next) {
+			frame->value_next = false;
+			const char *elem = frame->base + (frame->index++ * desc->array.elem_size);
+
+			return step_begin_value(encoder, elem, desc->array.elem_attr_desc);
+		}
+
+		if (frame->index == frame->count) {
+			encoder->depth--;
+			step_set_piece(encoder, "]", 1);
+			return BO_JSON_OK();
+		}
+
+		frame->value_next = true;
+		if (frame->index > 0) {
+			step_set_piece(encoder, ",", 1);
+			return BO_JSON_OK();
+		}
+	}
+}
+
+void bo_json_encoder_init(struct bo_json_encoder *encoder, const void *in,
+			  const struct bo_json_value_desc *in_desc)
+{
+	encoder->in = in;
+	encoder->in_desc = in_desc;
+	encoder->depth = 0;
+	encoder->started = false;
+	encoder->piece = NULL;
+	encoder->piece_len = 0;
+	encoder->str = NULL;
+	encoder->str_end = NULL;
+	encoder->str_close = NULL;
+}
+
+struct bo_json_error bo_json_encoder_step(struct bo_json_encoder *encoder, char *buf, size_t cap,
+					  size_t *written)
+{
+	struct bo_json_error err;
+	size_t n = 0;
+
+	for (;;) {
+		if (encoder->piece_len == 0) {
+			err = step_next(encoder);
+			if (err.err != BO_JSON_ERROR_NONE) {
+				*written = n;
+				return err;
+			}
+
+			if (encoder->piece == NULL) {
+				*written = n;
+				return BO_JSON_OK();
+			}
+		}
+
+		// the next piece is known, so a chunk ending with the value is reported complete
+		if (n == cap) {
+			*written = n;
+			return BO_JSON_ERROR(BO_JSON_ERROR_PARTIAL, NULL, NULL);
+		}
+
+		const size_t len = (encoder->piece_len < cap - n) ? encoder->piece_len : cap - n;
+
+		memcpy(buf + n, encoder->piece, len);
+		encoder->piece += len;
+		encoder->piece_len -= len;
+		n += len;
+	}
 }
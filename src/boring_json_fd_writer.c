@@ -0,0 +1,201 @@
+#include "boring_json_fd_writer.h"
+#include "boring_json.h"
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+
+static char *buffer_at(const struct bo_json_fd_writer *writer, size_t index)
+{
+	return writer->buf + (index * writer->buf_size);
+}
+
+static bool write_all(int fd, const char *data, size_t len)
+{
+	while (len > 0) {
+		const ssize_t ret = write(fd, data, len);
+
+		if (ret < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			return false;
+		}
+		if (ret == 0) {
+			return false;
+		}
+
+		data += ret;
+		len -= (size_t)ret;
+	}
+
+	return true;
+}
+
+static void *flusher(void *arg)
+{
+	struct bo_json_fd_writer *writer = arg;
+
+	pthread_mutex_lock(&writer->lock);
+	for (;;) {
+		while (writer->n_full == 0 && !writer->stop) {
+			pthread_cond_wait(&writer->cond, &writer->lock);
+		}
+
+		if (writer->n_full == 0) {
+			break;
+		}
+
+		const size_t index = writer->head;
+		// a failed writer keeps draining the buffers so that nobody waits forever
+		const bool failed = writer->err != BO_JSON_ERROR_NONE;
+		pthread_mutex_unlock(&writer->lock);
+
+		const char *buf = buffer_at(writer, index);
+		const bool ok = failed || write_all(writer->fd, buf, writer->lens[index]);
+
+		pthread_mutex_lock(&writer->lock);
+		if (!ok) {
+			writer->err = BO_JSON_ERROR_IO;
+		}
+		writer->head = (writer->head + 1) % writer->n_bufs;
+		writer->n_full--;
+		pthread_cond_broadcast(&writer->cond);
+	}
+	pthread_mutex_unlock(&writer->lock);
+
+	return NULL;
+}
+
+/**
+ * @brief Queue the buffer being filled, if not empty, and move the window to a free one
+ */
+static struct bo_json_error submit(struct bo_json_fd_writer *writer)
+{
+	const size_t len = (size_t)(writer->ctx.pos - buffer_at(writer, writer->fill));
+	enum bo_json_error_code err;
+
+	pthread_mutex_lock(&writer->lock);
+	if (len > 0) {
+		writer->lens[writer->fill] = len;
+		writer->fill = (writer->fill + 1) % writer->n_bufs;
+		writer->n_full++;
+		pthread_cond_broadcast(&writer->cond);
+	}
+
+	// the next buffer is free once fewer than all of them wait
+	while (writer->n_full == writer->n_bufs) {
+		pthread_cond_wait(&writer->cond, &writer->lock);
+	}
+	err = writer->err;
+	pthread_mutex_unlock(&writer->lock);
+
+	writer->ctx.pos = buffer_at(writer, writer->fill);
+	writer->ctx.end = writer->ctx.pos + writer->buf_size;
+
+	if (err != BO_JSON_ERROR_NONE) {
+		return BO_JSON_ERROR(err, NULL, NULL);
+	}
+
+	return BO_JSON_OK();
+}
+
+// only called when the data does not fit in what is left of the buffer being filled
+static struct bo_json_error _fd_write(struct bo_json_writer *writer, const void *data, size_t len)
+{
+	struct bo_json_fd_writer *fwriter = (struct bo_json_fd_writer *)writer;
+	const char *src = data;
+	struct bo_json_error err;
+
+	while (len > 0) {
+		if (fwriter->ctx.pos == fwriter->ctx.end) {
+			err = submit(fwriter);
+			if (err.err != BO_JSON_ERROR_NONE) {
+				return err;
+			}
+		}
+
+		size_t n = (size_t)(fwriter->ctx.end - fwriter->ctx.pos);
+
+		n = (len < n) ? len : n;
+		memcpy(fwriter->ctx.pos, src, n);
+		fwriter->ctx.pos += n;
+		src += n;
+		len -= n;
+	}
+
+	return BO_JSON_OK();
+}
+
+struct bo_json_error bo_json_fd_writer_flush(struct bo_json_fd_writer *writer)
+{
+	struct bo_json_error err;
+	enum bo_json_error_code code;
+
+	err = submit(writer);
+	if (err.err != BO_JSON_ERROR_NONE) {
+		return err;
+	}
+
+	pthread_mutex_lock(&writer->lock);
+	while (writer->n_full > 0) {
+		pthread_cond_wait(&writer->cond, &writer->lock);
+	}
+	code = writer->err;
+	pthread_mutex_unlock(&writer->lock);
+
+	if (code != BO_JSON_ERROR_NONE) {
+		return BO_JSON_ERROR(code, NULL, NULL);
+	}
+
+	return BO_JSON_OK();
+}
+
+struct bo_json_error bo_json_fd_writer_init(struct bo_json_fd_writer *writer, int fd, void *buf,
+					    size_t buf_size, size_t n_bufs)
+{
+	if (n_bufs == 0 || n_bufs > BO_JSON_FD_WRITER_MAX_BUFS || buf_size == 0) {
+		return BO_JSON_ERROR(BO_JSON_ERROR_NOT_SUPPORT, NULL, NULL);
+	}
+
+	bo_json_writer_init(&writer->ctx, _fd_write);
+	writer->fd = fd;
+	writer->buf = buf;
+	writer->buf_size = buf_size;
+	writer->n_bufs = n_bufs;
+	writer->fill = 0;
+	writer->head = 0;
+	writer->n_full = 0;
+	writer->stop = false;
+	writer->err = BO_JSON_ERROR_NONE;
+
+	writer->ctx.pos = writer->buf;
+	writer->ctx.end = writer->buf + buf_size;
+
+	pthread_mutex_init(&writer->lock, NULL);
+	pthread_cond_init(&writer->cond, NULL);
+
+	if (pthread_create(&writer->thread, NULL, flusher, writer) != 0) {
+		pthread_cond_destroy(&writer->cond);
+		pthread_mutex_destroy(&writer->lock);
+		return BO_JSON_ERROR(BO_JSON_ERROR_INSUFFICIENT_SPACE, NULL, NULL);
+	}
+
+	return BO_JSON_OK();
+}
+
+struct bo_json_error bo_json_fd_writer_cleanup(struct bo_json_fd_writer *writer)
+{
+	const struct bo_json_error err = bo_json_fd_writer_flush(writer);
+
+	pthread_mutex_lock(&writer->lock);
+	writer->stop = true;
+	pthread_cond_broadcast(&writer->cond);
+	pthread_mutex_unlock(&writer->lock);
+
+	pthread_join(writer->thread, NULL);
+	pthread_cond_destroy(&writer->cond);
+	pthread_mutex_destroy(&writer->lock);
+
+	return err;
+}
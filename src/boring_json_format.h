@@ -0,0 +1,90 @@
+#ifndef BORING_JSON_FORMAT_H_
+#define BORING_JSON_FORMAT_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* number to text conversions shared by the encoders, none of them writes a terminator */
+
+// "-9223372036854775808"
+#define BO_JSON_INT64_STR_MAX (20)
+
+// "-0.0000012345678901234567"
+#define BO_JSON_DOUBLE_STR_MAX (25)
+
+/**
+ * @brief Write the decimal representation of an unsigned integer
+ *
+ * @param[out] dest The destination, at least BO_JSON_INT64_STR_MAX bytes
+ * @param[in]  v    The value
+ * @return The number of bytes written
+ */
+size_t bo_json_format_uint64(char *dest, uint64_t v);
+
+/**
+ * @brief Write the decimal representation of a signed integer
+ *
+ * @param[out] dest The destination, at least BO_JSON_INT64_STR_MAX bytes
+ * @param[in]  v    The value
+ * @return The number of bytes written
+ */
+size_t bo_json_format_int64(char *dest, int64_t v);
+
+/**
+ * @brief The length of the decimal representation of an unsigned integer
+ */
+size_t bo_json_uint64_len(uint64_t v);
+
+/**
+ * @brief The length of the decimal representation of a signed integer
+ */
+size_t bo_json_int64_len(int64_t v);
+
+/**
+ * @brief Whether a double is neither infinite nor NaN
+ */
+bool bo_json_double_is_finite(double v);
+
+/**
+ * @brief Write the shortest decimal representation of a finite double which reads back as the
+ * same value
+ *
+ * Digits are produced with Schubfach: the fewest significant digits that round-trip, the
+ * closest to the exact value when several qualify. Integral values print without a fraction
+ * ("100"), values below 1e-5 or of 1e21 and above use an exponent ("1e-7", "1.5e300").
+ *
+ * @param[out] dest The destination, at least BO_JSON_DOUBLE_STR_MAX bytes
+ * @param[in]  v    A finite value
+ * @return The number of bytes written
+ */
+size_t bo_json_format_double(char *dest, double v);
+
+/**
+ * @brief The length bo_json_format_double() would write, without writing anything
+ *
+ * @param[in] v A finite value
+ * @return The number of bytes bo_json_format_double() writes for v
+ */
+size_t bo_json_double_len(double v);
+
+/**
+ * @brief Write a finite double rounded half away from zero to a fixed number of decimals
+ *
+ * The exact binary value is rounded, so 0.045 (0.04499999...) with 2 decimals is "0.04" like
+ * printf writes it: 2.5 with 2 decimals is "2.50", -0.001 is "0.00".
+ *
+ * @param[out] dest     The destination, at least BO_JSON_DOUBLE_STR_MAX bytes
+ * @param[in]  v        A finite value
+ * @param[in]  decimals The number of decimals, at most 9
+ * @return The number of bytes written, 0 without writing anything if decimals is above 9 or the
+ * magnitude scaled by 10^decimals is 2^63 or more
+ */
+size_t bo_json_format_fixed(char *dest, double v, unsigned int decimals);
+
+/**
+ * @brief The length bo_json_format_fixed() would write, without writing anything
+ */
+size_t bo_json_fixed_len(double v, unsigned int decimals);
+
+#endif /* BORING_JSON_FORMAT_H_ */
@@ -0,0 +1,141 @@
+#include "boring_json_iovec_writer.h"
+#include "boring_json.h"
+
+#include <errno.h>
+#include <string.h>
+#include <sys/uio.h>
+
+// writev until everything is written, the iovec entries are consumed
+static struct bo_json_error writev_all(int fd, struct iovec *iov, size_t n)
+{
+	while (n > 0) {
+		const ssize_t ret = writev(fd, iov, (int)n);
+
+		if (ret < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			return BO_JSON_ERROR(BO_JSON_ERROR_IO, NULL, NULL);
+		}
+
+		size_t done = (size_t)ret;
+
+		while (n > 0 && done >= iov->iov_len) {
+			done -= iov->iov_len;
+			iov++;
+			n--;
+		}
+
+		if (n > 0) {
+			if (ret == 0) {
+				return BO_JSON_ERROR(BO_JSON_ERROR_IO, NULL, NULL);
+			}
+			iov->iov_base = (char *)iov->iov_base + done;
+			iov->iov_len -= done;
+		}
+	}
+
+	return BO_JSON_OK();
+}
+
+// the caller makes sure there is room for one more entry
+static void push(struct bo_json_iovec_writer *writer, const void *data, size_t len)
+{
+	writer->iov[writer->iov_len].iov_base = (void *)data;
+	writer->iov[writer->iov_len].iov_len = len;
+	writer->iov_len++;
+}
+
+// reference what was copied in the side buffer since the last entry
+static void close_segment(struct bo_json_iovec_writer *writer)
+{
+	if (writer->ctx.pos > writer->seg) {
+		push(writer, writer->seg, (size_t)(writer->ctx.pos - writer->seg));
+		writer->seg = writer->ctx.pos;
+	}
+}
+
+struct bo_json_error bo_json_iovec_writer_flush(struct bo_json_iovec_writer *writer)
+{
+	struct bo_json_error err;
+
+	if (writer->ctx.pos > writer->seg && writer->iov_len == writer->iov_cap) {
+		err = writev_all(writer->fd, writer->iov, writer->iov_len);
+		writer->iov_len = 0;
+		if (err.err != BO_JSON_ERROR_NONE) {
+			return err;
+		}
+	}
+	close_segment(writer);
+
+	err = writev_all(writer->fd, writer->iov, writer->iov_len);
+	writer->iov_len = 0;
+	writer->ctx.pos = writer->buf;
+	writer->seg = writer->buf;
+
+	return err;
+}
+
+// only called when the data does not fit in what is left of the side buffer
+static struct bo_json_error _iovec_write(struct bo_json_writer *writer, const void *data,
+					 size_t len)
+{
+	struct bo_json_iovec_writer *iwriter = (struct bo_json_iovec_writer *)writer;
+	struct bo_json_error err;
+
+	err = bo_json_iovec_writer_flush(iwriter);
+	if (err.err != BO_JSON_ERROR_NONE) {
+		return err;
+	}
+
+	// the data is only valid during this call, write it now
+	if (len > iwriter->cap) {
+		struct iovec iov = {.iov_base = (void *)data, .iov_len = len};
+
+		return writev_all(iwriter->fd, &iov, 1);
+	}
+
+	memcpy(iwriter->ctx.pos, data, len);
+	iwriter->ctx.pos += len;
+	return BO_JSON_OK();
+}
+
+static struct bo_json_error _iovec_write_ref(struct bo_json_writer *writer, const void *data,
+					     size_t len)
+{
+	struct bo_json_iovec_writer *iwriter = (struct bo_json_iovec_writer *)writer;
+	struct bo_json_error err;
+
+	if (len < BO_JSON_IOVEC_WRITER_REF_MIN) {
+		return bo_json_writer_write(writer, data, len);
+	}
+
+	// one entry for the side buffer content before the reference, one for the reference
+	if (iwriter->iov_cap - iwriter->iov_len < 2) {
+		err = bo_json_iovec_writer_flush(iwriter);
+		if (err.err != BO_JSON_ERROR_NONE) {
+			return err;
+		}
+	}
+
+	close_segment(iwriter);
+	push(iwriter, data, len);
+	return BO_JSON_OK();
+}
+
+void bo_json_iovec_writer_init(struct bo_json_iovec_writer *writer, int fd, struct iovec *iov,
+			       size_t iov_cap, void *buf, size_t cap)
+{
+	bo_json_writer_init(&writer->ctx, _iovec_write);
+	writer->ctx.write_ref = _iovec_write_ref;
+	writer->fd = fd;
+	writer->iov = iov;
+	writer->iov_cap = iov_cap;
+	writer->iov_len = 0;
+	writer->buf = buf;
+	writer->cap = cap;
+	writer->seg = writer->buf;
+
+	writer->ctx.pos = writer->buf;
+	writer->ctx.end = writer->buf + cap;
+}
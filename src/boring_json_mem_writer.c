@@ -1,39 +1,89 @@
 #include "boring_json_mem_writer.h"
 #include "boring_json.h"
 
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
-struct bo_json_error _mem_write(struct bo_json_writer *writer, const void *data, size_t len)
+#if BO_JSON_MEM_WRITER_POOL_SIZE > 0
+struct pooled_buf {
+	void *buf;
+	size_t cap;
+};
+
+static _Thread_local struct pooled_buf pool[BO_JSON_MEM_WRITER_POOL_SIZE];
+static _Thread_local size_t n_pooled;
+#endif
+
+static void *_mem_resize(struct bo_json_mem_writer *mem_writer, void *ptr, size_t size)
 {
-	struct bo_json_mem_writer *mem_writer = (struct bo_json_mem_writer *)writer;
+	if (mem_writer->alloc) {
+		return mem_writer->alloc->resize(mem_writer->alloc->ctx, ptr, size);
+	}
+	return realloc(ptr, size);
+}
 
-	// Check if there's enough space in the buffer, if not realloc
-	if (mem_writer->len + len > mem_writer->cap) {
-		size_t new_cap;
+static void _mem_free(struct bo_json_mem_writer *mem_writer, void *ptr)
+{
+	if (mem_writer->alloc) {
+		mem_writer->alloc->release(mem_writer->alloc->ctx, ptr);
+	} else {
+		free(ptr);
+	}
+}
 
-		new_cap = mem_writer->cap == 0 ? len : mem_writer->cap + mem_writer->increase_bytes;
+/**
+ * @brief Make sure len more bytes fit in the buffer, growing it if needed
+ *
+ * The capacity at least doubles so that an output of n bytes costs O(log n) reallocations.
+ */
+static struct bo_json_error _mem_grow(struct bo_json_mem_writer *mem_writer, size_t len)
+{
+	size_t new_cap;
+	char *new_buf;
 
-		// Ensure new_cap does not exceed max_cap
-		if (new_cap > mem_writer->max_cap) {
-			new_cap = mem_writer->max_cap;
-		}
+	if (len <= mem_writer->cap - mem_writer->len) {
+		return BO_JSON_OK();
+	}
 
-		// Check if the new capacity is enough for the data
-		if (mem_writer->len + len > new_cap) {
-			return BO_JSON_ERROR(BO_JSON_ERROR_INSUFFICIENT_SPACE, NULL, NULL);
-		}
+	if (mem_writer->len > mem_writer->max_cap || len > mem_writer->max_cap - mem_writer->len) {
+		return BO_JSON_ERROR(BO_JSON_ERROR_INSUFFICIENT_SPACE, NULL, NULL);
+	}
 
-		// Reallocate the buffer to the new capacity
-		char *new_buf = realloc(mem_writer->buf, new_cap);
-		if (!new_buf) {
-			free(mem_writer->buf);
-			mem_writer->buf = NULL;
-			return BO_JSON_ERROR(BO_JSON_ERROR_INSUFFICIENT_SPACE, NULL, NULL);
+	new_cap = mem_writer->cap > SIZE_MAX / 2 ? SIZE_MAX : mem_writer->cap * 2;
+	if (new_cap - mem_writer->cap < mem_writer->increase_bytes) {
+		new_cap = mem_writer->cap + mem_writer->increase_bytes;
+		if (new_cap < mem_writer->cap) {
+			new_cap = SIZE_MAX;
 		}
+	}
+	if (new_cap < mem_writer->len + len) {
+		new_cap = mem_writer->len + len;
+	}
+	if (new_cap > mem_writer->max_cap) {
+		new_cap = mem_writer->max_cap;
+	}
 
-		mem_writer->buf = new_buf;
-		mem_writer->cap = new_cap;
+	// The old buffer is kept on failure
+	new_buf = _mem_resize(mem_writer, mem_writer->buf, new_cap);
+	if (!new_buf) {
+		return BO_JSON_ERROR(BO_JSON_ERROR_INSUFFICIENT_SPACE, NULL, NULL);
+	}
+
+	mem_writer->buf = new_buf;
+	mem_writer->cap = new_cap;
+
+	return BO_JSON_OK();
+}
+
+struct bo_json_error _mem_write(struct bo_json_writer *writer, const void *data, size_t len)
+{
+	struct bo_json_mem_writer *mem_writer = (struct bo_json_mem_writer *)writer;
+	struct bo_json_error err;
+
+	err = _mem_grow(mem_writer, len);
+	if (err.err != BO_JSON_ERROR_NONE) {
+		return err;
 	}
 
 	// Copy data to the buffer
@@ -43,12 +93,39 @@ struct bo_json_error _mem_write(struct bo_json_writer *writer, const void *data,
 	return BO_JSON_OK();
 }
 
+static char *_mem_reserve(struct bo_json_writer *writer, size_t len)
+{
+	struct bo_json_mem_writer *mem_writer = (struct bo_json_mem_writer *)writer;
+
+	if (_mem_grow(mem_writer, len).err != BO_JSON_ERROR_NONE) {
+		return NULL;
+	}
+
+	return (char *)mem_writer->buf + mem_writer->len;
+}
+
+static void _mem_commit(struct bo_json_writer *writer, size_t len)
+{
+	struct bo_json_mem_writer *mem_writer = (struct bo_json_mem_writer *)writer;
+
+	mem_writer->len += len;
+}
+
 void bo_json_mem_writer_init(struct bo_json_mem_writer *writer, size_t increase_bytes,
 			     size_t max_cap)
 {
-	writer->ctx.write = _mem_write;
+	bo_json_mem_writer_init_alloc(writer, increase_bytes, max_cap, NULL);
+}
+
+void bo_json_mem_writer_init_alloc(struct bo_json_mem_writer *writer, size_t increase_bytes,
+				   size_t max_cap, const struct bo_json_allocator *alloc)
+{
+	bo_json_writer_init(&writer->ctx, _mem_write);
+	writer->ctx.reserve = _mem_reserve;
+	writer->ctx.commit = _mem_commit;
 	writer->max_cap = max_cap;
 	writer->increase_bytes = increase_bytes;
+	writer->alloc = alloc;
 
 	writer->buf = NULL;
 	writer->cap = 0;
@@ -57,8 +134,63 @@ void bo_json_mem_writer_init(struct bo_json_mem_writer *writer, size_t increase_
 
 void bo_json_mem_writer_cleanup(struct bo_json_mem_writer *writer)
 {
-	free(writer->buf);
+	_mem_free(writer, writer->buf);
 	writer->buf = NULL;
 	writer->cap = 0;
 	writer->len = 0;
 }
+
+struct bo_json_error bo_json_mem_writer_reserve(struct bo_json_mem_writer *writer, size_t len)
+{
+	return _mem_grow(writer, len);
+}
+
+void bo_json_mem_writer_reset(struct bo_json_mem_writer *writer)
+{
+	writer->len = 0;
+}
+
+void bo_json_mem_writer_acquire(struct bo_json_mem_writer *writer, size_t increase_bytes,
+				size_t max_cap)
+{
+	bo_json_mem_writer_init(writer, increase_bytes, max_cap);
+
+#if BO_JSON_MEM_WRITER_POOL_SIZE > 0
+	// Most recently released first, its memory is the most likely to be in cache
+	for (size_t i = n_pooled; i-- > 0;) {
+		if (pool[i].cap <= max_cap) {
+			writer->buf = pool[i].buf;
+			writer->cap = pool[i].cap;
+			pool[i] = pool[--n_pooled];
+			break;
+		}
+	}
+#endif
+}
+
+void bo_json_mem_writer_release(struct bo_json_mem_writer *writer)
+{
+#if BO_JSON_MEM_WRITER_POOL_SIZE > 0
+	if (!writer->alloc && writer->buf && n_pooled < BO_JSON_MEM_WRITER_POOL_SIZE) {
+		pool[n_pooled].buf = writer->buf;
+		pool[n_pooled].cap = writer->cap;
+		n_pooled++;
+
+		writer->buf = NULL;
+		writer->cap = 0;
+		writer->len = 0;
+		return;
+	}
+#endif
+
+	bo_json_mem_writer_cleanup(writer);
+}
+
+void bo_json_mem_writer_pool_drain(void)
+{
+#if BO_JSON_MEM_WRITER_POOL_SIZE > 0
+	while (n_pooled > 0) {
+		free(pool[--n_pooled].buf);
+	}
+#endif
+}
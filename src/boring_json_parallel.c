@@ -0,0 +1,166 @@
+#include "boring_json_parallel.h"
+#include "boring_json.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SEGMENT_INITIAL_CAP (64 * 1024)
+
+/**
+ * @brief The output of one thread, a growing buffer entirely exposed as the inline window
+ */
+struct segment {
+	struct bo_json_writer out;
+	char *buf;
+
+	const char *array_base;
+	const struct bo_json_value_desc *elem_desc;
+	size_t elem_size;
+	size_t begin;
+	size_t end;
+
+	struct bo_json_error err;
+};
+
+// only called when the data does not fit in the window, doubles the buffer
+static struct bo_json_error segment_write(struct bo_json_writer *writer, const void *data,
+					  size_t len)
+{
+	struct segment *segment = (struct segment *)writer;
+	const size_t used = (size_t)(writer->pos - segment->buf);
+	size_t cap = (size_t)(writer->end - segment->buf);
+
+	while (cap - used < len) {
+		cap = (cap == 0) ? SEGMENT_INITIAL_CAP : cap * 2;
+	}
+
+	char *buf = realloc(segment->buf, cap);
+	if (buf == NULL) {
+		return BO_JSON_ERROR(BO_JSON_ERROR_INSUFFICIENT_SPACE, NULL, NULL);
+	}
+
+	segment->buf = buf;
+	writer->pos = buf + used;
+	writer->end = buf + cap;
+
+	memcpy(writer->pos, data, len);
+	writer->pos += len;
+	return BO_JSON_OK();
+}
+
+static void segment_init(struct segment *segment)
+{
+	bo_json_writer_init(&segment->out, segment_write);
+	segment->buf = NULL;
+	// an empty window, grown by the first write
+	segment->out.pos = segment->buf;
+	segment->out.end = segment->buf;
+}
+
+// encode the elements [begin, end) separated by commas
+static void *encode_segment(void *arg)
+{
+	struct segment *segment = arg;
+
+	segment->err = BO_JSON_OK();
+	for (size_t i = segment->begin; i < segment->end; i++) {
+		if (i > segment->begin) {
+			segment->err = bo_json_writer_write(&segment->out, ",", 1);
+			if (segment->err.err != BO_JSON_ERROR_NONE) {
+				break;
+			}
+		}
+
+		segment->err = bo_json_encode(segment->array_base + (i * segment->elem_size),
+					      segment->elem_desc, &segment->out);
+		if (segment->err.err != BO_JSON_ERROR_NONE) {
+			break;
+		}
+	}
+
+	return NULL;
+}
+
+struct bo_json_error bo_json_encode_parallel(const void *in,
+					     const struct bo_json_value_desc *in_desc,
+					     size_t n_threads, struct bo_json_writer *writer)
+{
+	struct segment segments[BO_JSON_PARALLEL_MAX_THREADS];
+	pthread_t threads[BO_JSON_PARALLEL_MAX_THREADS];
+	struct bo_json_error err = BO_JSON_OK();
+
+	if (in_desc->type != BO_JSON_VALUE_TYPE_ARRAY || n_threads == 0 ||
+	    n_threads > BO_JSON_PARALLEL_MAX_THREADS) {
+		return BO_JSON_ERROR(BO_JSON_ERROR_NOT_SUPPORT, NULL, in_desc);
+	}
+
+	const size_t count = *((size_t *)((const char *)in + in_desc->array.count_offset));
+
+	if (n_threads > count) {
+		n_threads = count;
+	}
+
+	if (n_threads <= 1) {
+		return bo_json_encode(in, in_desc, writer);
+	}
+
+	// the calling thread encodes the first segment itself
+	size_t n_started = 1;
+
+	for (size_t t = 0; t < n_threads; t++) {
+		struct segment *segment = &segments[t];
+
+		segment->array_base = (const char *)in + in_desc->value_offset;
+		segment->elem_desc = in_desc->array.elem_attr_desc;
+		segment->elem_size = in_desc->array.elem_size;
+		segment->begin = (count * t) / n_threads;
+		segment->end = (count * (t + 1)) / n_threads;
+		segment_init(segment);
+
+		if (t > 0) {
+			if (pthread_create(&threads[t], NULL, encode_segment, segment) != 0) {
+				err = BO_JSON_ERROR(BO_JSON_ERROR_INSUFFICIENT_SPACE, NULL,
+						    in_desc);
+				break;
+			}
+			n_started++;
+		}
+	}
+
+	encode_segment(&segments[0]);
+
+	for (size_t t = 1; t < n_started; t++) {
+		pthread_join(threads[t], NULL);
+	}
+
+	for (size_t t = 0; t < n_started && err.err == BO_JSON_ERROR_NONE; t++) {
+		err = segments[t].err;
+	}
+
+	if (err.err == BO_JSON_ERROR_NONE) {
+		err = bo_json_writer_write(writer, "[", 1);
+	}
+
+	for (size_t t = 0; t < n_started && err.err == BO_JSON_ERROR_NONE; t++) {
+		if (t > 0) {
+			err = bo_json_writer_write(writer, ",", 1);
+		}
+		if (err.err == BO_JSON_ERROR_NONE) {
+			const struct segment *segment = &segments[t];
+
+			err = bo_json_writer_write(writer, segment->buf,
+						   (size_t)(segment->out.pos - segment->buf));
+		}
+	}
+
+	if (err.err == BO_JSON_ERROR_NONE) {
+		err = bo_json_writer_write(writer, "]", 1);
+	}
+
+	for (size_t t = 0; t < n_started; t++) {
+		free(segments[t].buf);
+	}
+
+	return err;
+}
@@ -15,9 +15,29 @@ struct bo_json_error _simple_write(struct bo_json_writer *writer, const void *da
 	return BO_JSON_OK();
 }
 
+static char *_simple_reserve(struct bo_json_writer *writer, size_t len)
+{
+	struct bo_json_simple_writer *swriter = (struct bo_json_simple_writer *)writer;
+
+	if (swriter->cap - swriter->len < len) {
+		return NULL;
+	}
+
+	return (char *)swriter->buf + swriter->len;
+}
+
+static void _simple_commit(struct bo_json_writer *writer, size_t len)
+{
+	struct bo_json_simple_writer *swriter = (struct bo_json_simple_writer *)writer;
+
+	swriter->len += len;
+}
+
 void bo_json_simple_writer_init(struct bo_json_simple_writer *writer, void *outbuf, size_t cap)
 {
-	writer->ctx.write = _simple_write;
+	bo_json_writer_init(&writer->ctx, _simple_write);
+	writer->ctx.reserve = _simple_reserve;
+	writer->ctx.commit = _simple_commit;
 	writer->buf = outbuf;
 	writer->cap = cap;
 	writer->len = 0;
@@ -12,17 +12,46 @@ extern void test_decode_array_int(void);
 extern void test_decode_array_double(void);
 extern void test_decode_array_cstr(void);
 extern void test_decode_object_nest(void);
+extern void test_decode_reset_presence(void);
+extern void test_decode_projection(void);
+extern void test_decode_stop_when_complete(void);
+extern void test_decode_merge(void);
+extern void test_decode_merge_array_elements(void);
+extern void test_decode_multi(void);
 
 extern void test_encode_bool(void);
 extern void test_encode_int(void);
+extern void test_encode_int_digits(void);
 extern void test_encode_double(void);
+extern void test_encode_double_format(void);
+extern void test_encode_double_roundtrip(void);
+extern void test_encode_double_nonfinite(void);
+extern void test_encode_double_fixed(void);
 extern void test_encode_cstr(void);
+extern void test_encode_cstr_escape(void);
 extern void test_encode_object_primitive_types(void);
+extern void test_encode_object_key(void);
 extern void test_encode_array_bool(void);
 extern void test_encode_array_int(void);
 extern void test_encode_array_double(void);
 extern void test_encode_array_cstr(void);
 extern void test_encode_object_nest(void);
+extern void test_encode_buffered_writer(void);
+extern void test_encode_write_only_writer(void);
+extern void test_encode_reserve(void);
+extern void test_encode_mem_writer(void);
+extern void test_encode_iovec_writer(void);
+extern void test_encode_fd_writer(void);
+extern void test_encode_encoded_size(void);
+extern void test_encode_max_encoded_size(void);
+extern void test_encode_step(void);
+extern void test_encode_parallel(void);
+extern void test_encode_ndjson(void);
+extern void test_encode_delta(void);
+extern void test_encode_cached(void);
+extern void test_encode_template(void);
+extern void test_encode_generator(void);
+extern void test_encode_projection(void);
 
 void setUp(void)
 {
@@ -51,17 +80,46 @@ int main(int argc, char *argv[])
 	RUN_TEST(test_decode_array_double);
 	RUN_TEST(test_decode_array_cstr);
 	RUN_TEST(test_decode_object_nest);
+	RUN_TEST(test_decode_reset_presence);
+	RUN_TEST(test_decode_projection);
+	RUN_TEST(test_decode_stop_when_complete);
+	RUN_TEST(test_decode_merge);
+	RUN_TEST(test_decode_merge_array_elements);
+	RUN_TEST(test_decode_multi);
 
 	RUN_TEST(test_encode_bool);
 	RUN_TEST(test_encode_int);
+	RUN_TEST(test_encode_int_digits);
 	RUN_TEST(test_encode_double);
+	RUN_TEST(test_encode_double_format);
+	RUN_TEST(test_encode_double_roundtrip);
+	RUN_TEST(test_encode_double_nonfinite);
+	RUN_TEST(test_encode_double_fixed);
 	RUN_TEST(test_encode_cstr);
+	RUN_TEST(test_encode_cstr_escape);
 	RUN_TEST(test_encode_object_primitive_types);
+	RUN_TEST(test_encode_object_key);
 	RUN_TEST(test_encode_array_bool);
 	RUN_TEST(test_encode_array_int);
 	RUN_TEST(test_encode_array_double);
 	RUN_TEST(test_encode_array_cstr);
 	RUN_TEST(test_encode_object_nest);
+	RUN_TEST(test_encode_buffered_writer);
+	RUN_TEST(test_encode_write_only_writer);
+	RUN_TEST(test_encode_reserve);
+	RUN_TEST(test_encode_mem_writer);
+	RUN_TEST(test_encode_iovec_writer);
+	RUN_TEST(test_encode_fd_writer);
+	RUN_TEST(test_encode_encoded_size);
+	RUN_TEST(test_encode_max_encoded_size);
+	RUN_TEST(test_encode_step);
+	RUN_TEST(test_encode_parallel);
+	RUN_TEST(test_encode_ndjson);
+	RUN_TEST(test_encode_delta);
+	RUN_TEST(test_encode_cached);
+	RUN_TEST(test_encode_template);
+	RUN_TEST(test_encode_generator);
+	RUN_TEST(test_encode_projection);
 
 	return (UnityEnd());
 }
@@ -646,3 +646,342 @@ void test_decode_object_nest(void)
 	TEST_ASSERT_EQUAL_INT_ARRAY(expect.nest1.nest2.arr_integer, actual.nest1.nest2.arr_integer,
 				    expect.nest1.nest2.arr_integer_count);
 }
+
+void test_decode_reset_presence(void)
+{
+	// clang-format off
+	const char *first = "{"
+		"\"f\": false,"
+		"\"positive_int\": 100,"
+		"\"str\": \"boring json\","
+		"\"positive_int_null\": null"
+	"}";
+	const char *second = "{"
+		"\"t\": true,"
+		"\"str\": \"reused\""
+	"}";
+	// clang-format on
+
+	struct prims actual;
+	struct bo_json_error err;
+
+	// the struct is deliberately left dirty between decodes
+	memset(&actual, 0xA5, sizeof(actual));
+
+	err = bo_json_decode_ex(first, strlen(first), &prims_desc, &actual,
+				BO_JSON_DECODE_FLAGS_RESET_PRESENCE, NULL);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	TEST_ASSERT_TRUE(actual.f_exist);
+	TEST_ASSERT_FALSE(actual.t_exist);
+	TEST_ASSERT_TRUE(actual.positive_int_exist);
+	TEST_ASSERT_EQUAL_INT(100, actual.positive_int);
+	TEST_ASSERT_FALSE(actual.negative_int_exist);
+	TEST_ASSERT_TRUE(actual.str_exist);
+	TEST_ASSERT_EQUAL_STRING("boring json", actual.str);
+	TEST_ASSERT_FALSE(actual.arr_integer_exist);
+	TEST_ASSERT_TRUE(actual.positive_int_null_exist);
+	TEST_ASSERT_EQUAL(BO_JSON_NULL_BIT, actual.positive_int_null_flags & BO_JSON_NULL_BIT);
+	TEST_ASSERT_FALSE(actual.str_null_exist);
+	TEST_ASSERT_EQUAL(0, actual.str_null_flags & BO_JSON_NULL_BIT);
+
+	err = bo_json_decode_ex(second, strlen(second), &prims_desc, &actual,
+				BO_JSON_DECODE_FLAGS_RESET_PRESENCE, NULL);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	TEST_ASSERT_FALSE(actual.f_exist);
+	TEST_ASSERT_TRUE(actual.t_exist);
+	TEST_ASSERT_TRUE(actual.t);
+	TEST_ASSERT_FALSE(actual.positive_int_exist);
+	TEST_ASSERT_TRUE(actual.str_exist);
+	TEST_ASSERT_EQUAL_STRING("reused", actual.str);
+	TEST_ASSERT_FALSE(actual.positive_int_null_exist);
+	TEST_ASSERT_EQUAL(0, actual.positive_int_null_flags & BO_JSON_NULL_BIT);
+}
+
+void test_decode_projection(void)
+{
+	// clang-format off
+	const char *input = "{"
+		"\"nest1\": {"
+			"\"nest2\": {"
+				"\"f\": false,"
+				"\"t\": true,"
+				"\"positive_int\": 100,"
+				"\"negative_int\": -100,"
+				"\"str\": \"boring json\","
+				"\"arr_integer\": [0,1,-1,2,-2,3,-3]"
+			"}"
+		"}"
+	"}";
+	// clang-format on
+
+	// obj_nest_2_attrs: [1] t, [2] positive_int, [6] str
+	const struct bo_json_projection nest2_proj = {
+		.mask = BO_JSON_PROJECTION_BIT(1) | BO_JSON_PROJECTION_BIT(2) |
+			BO_JSON_PROJECTION_BIT(6),
+	};
+	const struct bo_json_projection *const nest1_children[] = {&nest2_proj};
+	const struct bo_json_projection nest1_proj = {
+		.mask = BO_JSON_PROJECTION_ALL,
+		.attrs = nest1_children,
+	};
+	const struct bo_json_projection *const root_children[] = {&nest1_proj};
+	const struct bo_json_projection root_proj = {
+		.mask = BO_JSON_PROJECTION_ALL,
+		.attrs = root_children,
+	};
+
+	struct obj_root actual = {0};
+	struct bo_json_error err;
+
+	err = bo_json_decode_ex(input, strlen(input), &obj_root_desc, &actual,
+				BO_JSON_DECODE_FLAGS_NONE, &root_proj);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+
+	TEST_ASSERT_TRUE(actual.nest1_exist);
+	TEST_ASSERT_TRUE(actual.nest1.nest2_exist);
+	TEST_ASSERT_FALSE(actual.nest1.nest2.f_exist);
+	TEST_ASSERT_TRUE(actual.nest1.nest2.t_exist);
+	TEST_ASSERT_TRUE(actual.nest1.nest2.t);
+	TEST_ASSERT_TRUE(actual.nest1.nest2.positive_int_exist);
+	TEST_ASSERT_EQUAL_INT(100, actual.nest1.nest2.positive_int);
+	TEST_ASSERT_FALSE(actual.nest1.nest2.negative_int_exist);
+	TEST_ASSERT_EQUAL_INT(0, actual.nest1.nest2.negative_int);
+	TEST_ASSERT_TRUE(actual.nest1.nest2.str_exist);
+	TEST_ASSERT_EQUAL_STRING("boring json", actual.nest1.nest2.str);
+	TEST_ASSERT_FALSE(actual.nest1.nest2.arr_integer_exist);
+	TEST_ASSERT_EQUAL_INT(0, actual.nest1.nest2.arr_integer_count);
+
+	// projected-out values are still validated
+	const char *invalid = "{\"nest1\": {\"nest2\": {\"f\": fals}}}";
+	err = bo_json_decode_ex(invalid, strlen(invalid), &obj_root_desc, &actual,
+				BO_JSON_DECODE_FLAGS_NONE, &root_proj);
+	TEST_ASSERT_NOT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+}
+
+void test_decode_stop_when_complete(void)
+{
+	// the document is truncated on purpose, the decoder never gets there
+	// clang-format off
+	const char *input = "{"
+		"\"positive_int\": 100,"
+		"\"str\": \"boring json\","
+		"\"negative_int\": -100,"
+		"\"arr_integer\": [0,1,-1,2,-2,3,-3";
+	// clang-format on
+
+	// prims_attrs: [2] positive_int, [6] str
+	const struct bo_json_projection proj = {
+		.mask = BO_JSON_PROJECTION_BIT(2) | BO_JSON_PROJECTION_BIT(6),
+	};
+
+	struct prims actual = {0};
+	struct bo_json_error err;
+
+	err = bo_json_decode_ex(input, strlen(input), &prims_desc, &actual,
+				BO_JSON_DECODE_FLAGS_STOP_WHEN_COMPLETE, &proj);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	TEST_ASSERT_EQUAL_PTR(strstr(input, ",\"negative_int\""), err.pos);
+	TEST_ASSERT_TRUE(actual.positive_int_exist);
+	TEST_ASSERT_EQUAL_INT(100, actual.positive_int);
+	TEST_ASSERT_TRUE(actual.str_exist);
+	TEST_ASSERT_EQUAL_STRING("boring json", actual.str);
+	TEST_ASSERT_FALSE(actual.negative_int_exist);
+
+	// without the flag the truncated tail is reported
+	err = bo_json_decode_ex(input, strlen(input), &prims_desc, &actual,
+				BO_JSON_DECODE_FLAGS_NONE, &proj);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_PARTIAL, err.err);
+}
+
+void test_decode_merge(void)
+{
+	// clang-format off
+	const char *input = "{\"nest1\": {\"nest2\": {"
+		"\"t\": true,"
+		"\"positive_int\": 200,"
+		"\"str\": \"boring json\","
+		"\"arr_integer\": [0,1,-1,2,-2,3,-3]"
+		"}}}";
+	// clang-format on
+
+	struct bo_json_changes nest2_changes = {0};
+	struct bo_json_changes *const nest1_attrs[] = {&nest2_changes};
+	struct bo_json_changes nest1_changes = {.attrs = nest1_attrs};
+	struct bo_json_changes *const root_attrs[] = {&nest1_changes};
+	struct bo_json_changes changes = {.attrs = root_attrs};
+
+	struct obj_root actual = {0};
+	struct bo_json_error err;
+
+	err = bo_json_decode(input, strlen(input), &obj_root_desc, &actual);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	actual.nest1.nest2.positive_int = 100;
+	actual.nest1.nest2.negative_int = -100;
+	actual.nest1.nest2.negative_int_exist = true;
+
+	// obj_nest_2_attrs: [1] t, [2] positive_int, [6] str, [7] arr_integer
+	err = bo_json_decode_merge(input, strlen(input), &obj_root_desc, &actual, &changes);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	TEST_ASSERT_EQUAL_UINT64(BO_JSON_PROJECTION_BIT(0), changes.mask);
+	TEST_ASSERT_EQUAL_UINT64(BO_JSON_PROJECTION_BIT(0), nest1_changes.mask);
+	TEST_ASSERT_EQUAL_UINT64(BO_JSON_PROJECTION_BIT(2), nest2_changes.mask);
+	TEST_ASSERT_EQUAL_INT(200, actual.nest1.nest2.positive_int);
+	TEST_ASSERT_EQUAL_INT(-100, actual.nest1.nest2.negative_int);
+	TEST_ASSERT_TRUE(actual.nest1.nest2.negative_int_exist);
+
+	// merging the same document again changes nothing
+	err = bo_json_decode_merge(input, strlen(input), &obj_root_desc, &actual, &changes);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	TEST_ASSERT_EQUAL_UINT64(0, changes.mask);
+	TEST_ASSERT_EQUAL_UINT64(0, nest1_changes.mask);
+	TEST_ASSERT_EQUAL_UINT64(0, nest2_changes.mask);
+
+	// a new attribute, a shorter string and a shorter array are all changes
+	const char *update = "{\"nest1\": {\"nest2\": {"
+			     "\"f\": false, \"str\": \"boring\", \"arr_integer\": [0,1]}}}";
+	err = bo_json_decode_merge(update, strlen(update), &obj_root_desc, &actual, &changes);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	TEST_ASSERT_EQUAL_UINT64(BO_JSON_PROJECTION_BIT(0) | BO_JSON_PROJECTION_BIT(6) |
+					BO_JSON_PROJECTION_BIT(7),
+				nest2_changes.mask);
+	TEST_ASSERT_TRUE(bo_json_changes_test(&changes, 0));
+	TEST_ASSERT_EQUAL_STRING("boring", actual.nest1.nest2.str);
+	TEST_ASSERT_EQUAL(2, actual.nest1.nest2.arr_integer_count);
+}
+
+void test_decode_merge_array_elements(void)
+{
+	struct elem {
+		int a;
+		bool a_exist;
+		int b;
+		bool b_exist;
+	};
+
+	struct elems {
+		struct elem arr[2];
+		bool arr_exist;
+		size_t arr_count;
+	};
+
+	static const struct bo_json_obj_attr_desc elem_attrs[] = {
+		BO_JSON_OBJECT_ATTR_INT(struct elem, a),
+		BO_JSON_OBJECT_ATTR_INT(struct elem, b),
+	};
+	static const struct bo_json_value_desc elem_desc = BO_JSON_VALUE_OBJECT(elem_attrs);
+	static const struct bo_json_obj_attr_desc elems_attrs[] = {
+		BO_JSON_OBJECT_ATTR_ARRAY(struct elems, arr, &elem_desc, 2, arr_count),
+	};
+	static const struct bo_json_value_desc elems_desc = BO_JSON_VALUE_OBJECT(elems_attrs);
+
+	struct bo_json_changes arr_changes = {0};
+	struct bo_json_changes *const root_attrs[] = {&arr_changes};
+	struct bo_json_changes changes = {.attrs = root_attrs};
+
+	struct elems actual = {0};
+	struct bo_json_error err;
+
+	const char *input = "{\"arr\": [{\"a\": 1, \"b\": 2}]}";
+	err = bo_json_decode_merge(input, strlen(input), &elems_desc, &actual, &changes);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	TEST_ASSERT_TRUE(actual.arr[0].b_exist);
+
+	// the same elements again change nothing
+	err = bo_json_decode_merge(input, strlen(input), &elems_desc, &actual, &changes);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	TEST_ASSERT_EQUAL_UINT64(0, changes.mask);
+	TEST_ASSERT_EQUAL_UINT64(0, arr_changes.mask);
+
+	// an element is replaced, the attribute it no longer has is gone and reported
+	const char *update = "{\"arr\": [{\"a\": 5}]}";
+	err = bo_json_decode_merge(update, strlen(update), &elems_desc, &actual, &changes);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	TEST_ASSERT_EQUAL(1, actual.arr_count);
+	TEST_ASSERT_EQUAL_INT(5, actual.arr[0].a);
+	TEST_ASSERT_TRUE(actual.arr[0].a_exist);
+	TEST_ASSERT_FALSE(actual.arr[0].b_exist);
+	TEST_ASSERT_EQUAL_UINT64(BO_JSON_PROJECTION_BIT(0), changes.mask);
+	TEST_ASSERT_EQUAL_UINT64(BO_JSON_PROJECTION_BIT(0) | BO_JSON_PROJECTION_BIT(1),
+				 arr_changes.mask);
+
+	// dropping the attribute alone is a change as well
+	const char *same_a = "{\"arr\": [{\"a\": 5, \"b\": 2}]}";
+	err = bo_json_decode_merge(same_a, strlen(same_a), &elems_desc, &actual, &changes);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	TEST_ASSERT_EQUAL_UINT64(BO_JSON_PROJECTION_BIT(1), arr_changes.mask);
+	err = bo_json_decode_merge(update, strlen(update), &elems_desc, &actual, &changes);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	TEST_ASSERT_EQUAL_UINT64(BO_JSON_PROJECTION_BIT(0), changes.mask);
+	TEST_ASSERT_EQUAL_UINT64(BO_JSON_PROJECTION_BIT(1), arr_changes.mask);
+	TEST_ASSERT_FALSE(actual.arr[0].b_exist);
+}
+
+struct prims_subset {
+	int positive_int;
+	bool positive_int_exist;
+
+	char str[16];
+	bool str_exist;
+
+	int arr_integer[4];
+	bool arr_integer_exist;
+	size_t arr_integer_count;
+};
+
+static const struct bo_json_obj_attr_desc prims_subset_attrs[] = {
+	BO_JSON_OBJECT_ATTR_INT(struct prims_subset, positive_int),
+	BO_JSON_OBJECT_ATTR_CSTR_ARRAY(struct prims_subset, str),
+	BO_JSON_OBJECT_ATTR_ARRAY(struct prims_subset, arr_integer, &bo_json_int_desc, 4,
+				  arr_integer_count),
+};
+
+static const struct bo_json_value_desc prims_subset_desc = BO_JSON_VALUE_OBJECT(prims_subset_attrs);
+
+void test_decode_multi(void)
+{
+	// clang-format off
+	const char *input = "{"
+		"\"t\": true,"
+		"\"positive_int\": 100,"
+		"\"negative_int\": -100,"
+		"\"str\": \"boring json\","
+		"\"arr_integer\": [0,1,-1,2,-2,3,-3],"
+		"\"positive_int_null\": null"
+	"}";
+	// clang-format on
+
+	struct prims full = {0};
+	struct prims_subset subset = {0};
+	const struct bo_json_decode_target targets[] = {
+		{.desc = &prims_desc, .out = &full},
+		{.desc = &prims_subset_desc, .out = &subset},
+		{.desc = NULL, .out = NULL},
+	};
+	struct bo_json_error err;
+
+	err = bo_json_decode_multi(input, strlen(input), targets, BO_ARRAY_SIZE(targets));
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	TEST_ASSERT_EQUAL_PTR(input + strlen(input), err.pos);
+
+	TEST_ASSERT_TRUE(full.t_exist);
+	TEST_ASSERT_TRUE(full.t);
+	TEST_ASSERT_EQUAL_INT(100, full.positive_int);
+	TEST_ASSERT_EQUAL_INT(-100, full.negative_int);
+	TEST_ASSERT_EQUAL_STRING("boring json", full.str);
+	TEST_ASSERT_EQUAL(7, full.arr_integer_count);
+	TEST_ASSERT_TRUE(full.positive_int_null_exist);
+	TEST_ASSERT_EQUAL(BO_JSON_NULL_BIT, full.positive_int_null_flags);
+
+	TEST_ASSERT_TRUE(subset.positive_int_exist);
+	TEST_ASSERT_EQUAL_INT(100, subset.positive_int);
+	TEST_ASSERT_TRUE(subset.str_exist);
+	TEST_ASSERT_EQUAL_STRING("boring json", subset.str);
+	TEST_ASSERT_TRUE(subset.arr_integer_exist);
+	TEST_ASSERT_EQUAL(4, subset.arr_integer_count);
+	TEST_ASSERT_EQUAL_INT_ARRAY(((int[]){0, 1, -1, 2}), subset.arr_integer, 4);
+
+	// the targets disagree on the shape of "str"
+	const char *mismatch = "{\"str\": [1]}";
+	err = bo_json_decode_multi(mismatch, strlen(mismatch), targets, 2);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_TYPE_NOT_MATCH, err.err);
+}
@@ -1,10 +1,21 @@
+#include <errno.h>
+#include <inttypes.h>
+#include <limits.h>
+#include <math.h>
 #include <stdbool.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 
 #include "unity.h"
 #include "boring_json.h"
 #include "boring_json_simple_writer.h"
+#include "boring_json_buffered_writer.h"
+#include "boring_json_mem_writer.h"
+#include "boring_json_iovec_writer.h"
+#include "boring_json_fd_writer.h"
+#include "boring_json_parallel.h"
 
 static char error_message[256];
 
@@ -59,6 +70,58 @@ void test_encode_int(void)
 	}
 }
 
+void test_encode_int_digits(void)
+{
+	const int64_t inputs[] = {
+		0,
+		9,
+		10,
+		99,
+		100,
+		-1,
+		-10,
+		123456789,
+		-1234567890,
+		INT32_MAX,
+		INT32_MIN,
+		(int64_t)UINT32_MAX + 1,
+		9999999999999999LL,
+		-10000000000000000LL,
+		INT64_MAX,
+		INT64_MIN,
+	};
+
+	struct bo_json_simple_writer writer;
+	char expect[24];
+	char buf[24];
+
+	for (size_t i = 0; i < BO_ARRAY_SIZE(inputs); i++) {
+		sprintf(error_message, "testcase[%zu]", i);
+
+		if (inputs[i] >= INT32_MIN && inputs[i] <= INT32_MAX) {
+			const int input = (int)inputs[i];
+
+			snprintf(expect, sizeof(expect), "%d", input);
+			memset(buf, 0, sizeof(buf));
+			bo_json_simple_writer_init(&writer, buf, sizeof(buf));
+			struct bo_json_error err =
+				bo_json_encode(&input, &bo_json_int_desc, &writer.ctx);
+
+			TEST_ASSERT_EQUAL_MESSAGE(BO_JSON_ERROR_NONE, err.err, error_message);
+			TEST_ASSERT_EQUAL_STRING_MESSAGE(expect, buf, error_message);
+		}
+
+		snprintf(expect, sizeof(expect), "%" PRIi64, inputs[i]);
+		memset(buf, 0, sizeof(buf));
+		bo_json_simple_writer_init(&writer, buf, sizeof(buf));
+		struct bo_json_error err =
+			bo_json_encode(&inputs[i], &bo_json_int64_desc, &writer.ctx);
+
+		TEST_ASSERT_EQUAL_MESSAGE(BO_JSON_ERROR_NONE, err.err, error_message);
+		TEST_ASSERT_EQUAL_STRING_MESSAGE(expect, buf, error_message);
+	}
+}
+
 void test_encode_double(void)
 {
 	const struct {
@@ -85,6 +148,290 @@ void test_encode_double(void)
 	}
 }
 
+void test_encode_double_format(void)
+{
+	const struct {
+		double input;
+		const char *expect;
+	} testcases[] = {
+		{.input = 0.0, .expect = "0"},
+		{.input = -0.0, .expect = "-0"},
+		{.input = 100.0, .expect = "100"},
+		{.input = 0.1 + 0.2, .expect = "0.30000000000000004"},
+		{.input = 1.5e-5, .expect = "0.000015"},
+		{.input = 1e-7, .expect = "1e-7"},
+		{.input = 1e20, .expect = "100000000000000000000"},
+		{.input = 1e21, .expect = "1e21"},
+		{.input = -1.25e300, .expect = "-1.25e300"},
+		{.input = 5e-324, .expect = "5e-324"},
+		{.input = 1.7976931348623157e308, .expect = "1.7976931348623157e308"},
+	};
+
+	struct bo_json_simple_writer writer;
+	char buf[32];
+
+	for (size_t i = 0; i < BO_ARRAY_SIZE(testcases); i++) {
+		sprintf(error_message, "testcase[%zu]", i);
+
+		memset(buf, 0, sizeof(buf));
+		bo_json_simple_writer_init(&writer, buf, sizeof(buf));
+		struct bo_json_error err =
+			bo_json_encode(&testcases[i].input, &bo_json_double_desc, &writer.ctx);
+
+		TEST_ASSERT_EQUAL_MESSAGE(BO_JSON_ERROR_NONE, err.err, error_message);
+		TEST_ASSERT_EQUAL_STRING_MESSAGE(testcases[i].expect, buf, error_message);
+	}
+}
+
+static bool encode_decode_double(double input, double *output, char *str, size_t *len)
+{
+	struct bo_json_simple_writer writer;
+	struct bo_json_error err;
+
+	bo_json_simple_writer_init(&writer, str, 32);
+	err = bo_json_encode(&input, &bo_json_double_desc, &writer.ctx);
+	if (err.err != BO_JSON_ERROR_NONE) {
+		return false;
+	}
+
+	*len = writer.len;
+	err = bo_json_decode(str, writer.len, &bo_json_double_desc, output);
+	return err.err == BO_JSON_ERROR_NONE;
+}
+
+// significant digits of a number, leading and trailing zeros excluded
+static int significant_digits(const char *str, size_t len)
+{
+	int first = -1;
+	int last = -1;
+
+	for (size_t i = 0; i < len && str[i] != 'e'; i++) {
+		if (str[i] >= '1' && str[i] <= '9') {
+			first = (first < 0) ? (int)i : first;
+			last = (int)i;
+		}
+	}
+
+	int digits = 0;
+
+	for (int i = first; i >= 0 && i <= last; i++) {
+		digits += (str[i] >= '0' && str[i] <= '9');
+	}
+
+	return digits;
+}
+
+// the fewest significant digits printf needs for the value to read back, at most 17
+static int shortest_digits(double input)
+{
+	char str[32];
+	int precision;
+
+	for (precision = 1; precision < 17; precision++) {
+		snprintf(str, sizeof(str), "%.*g", precision, input);
+		if (strtod(str, NULL) == input) {
+			break;
+		}
+	}
+
+	return precision;
+}
+
+void test_encode_double_roundtrip(void)
+{
+	uint64_t state = 0x9E3779B97F4A7C15ULL;
+	uint64_t n_checked = 0;
+
+	// every power of two and ten, then random bit patterns of every magnitude
+	for (int i = 0; i < 2098 + 632 + 100000; i++) {
+		double input;
+
+		if (i < 2098) {
+			// 52 subnormal then 2046 normal powers of two, built from their bit pattern
+			const uint64_t bits = (i < 52) ? (1ULL << i) : ((uint64_t)(i - 51) << 52);
+
+			memcpy(&input, &bits, sizeof(input));
+		} else if (i < 2098 + 632) {
+			char str[16];
+
+			snprintf(str, sizeof(str), "1e%d", i - 2098 - 323);
+			input = strtod(str, NULL);
+		} else {
+			state ^= state << 13;
+			state ^= state >> 7;
+			state ^= state << 17;
+			memcpy(&input, &state, sizeof(input));
+		}
+
+		if (!isfinite(input) || input == 0) {
+			continue;
+		}
+
+		double output;
+		char str[32];
+		size_t len;
+
+		sprintf(error_message, "input %.17g", input);
+		TEST_ASSERT_TRUE_MESSAGE(encode_decode_double(input, &output, str, &len),
+					 error_message);
+		TEST_ASSERT_EQUAL_MEMORY_MESSAGE(&input, &output, sizeof(input), error_message);
+		// printf only tries the nearest decimal of each precision, the encoder may do
+		// better next to a power of two where the rounding interval is asymmetric
+		TEST_ASSERT_TRUE_MESSAGE(significant_digits(str, len) <= shortest_digits(input),
+					 error_message);
+		n_checked++;
+	}
+
+	TEST_ASSERT_TRUE(n_checked > 100000);
+}
+
+void test_encode_double_nonfinite(void)
+{
+	struct doubles {
+		double error;
+		bool error_exist;
+		double null;
+		bool null_exist;
+		double string;
+		bool string_exist;
+	};
+
+	const struct bo_json_obj_attr_desc doubles_attrs[] = {
+		BO_JSON_OBJECT_ATTR_DOUBLE(struct doubles, error),
+		BO_JSON_OBJECT_ATTR_DOUBLE_NONFINITE(struct doubles, null,
+						     BO_JSON_FLAGS_NONFINITE_NULL),
+		BO_JSON_OBJECT_ATTR_DOUBLE_NONFINITE(struct doubles, string,
+						     BO_JSON_FLAGS_NONFINITE_STRING),
+	};
+	const struct bo_json_value_desc doubles_desc = BO_JSON_VALUE_OBJECT(doubles_attrs);
+
+	struct doubles input = {
+		.null = INFINITY,
+		.null_exist = true,
+		.string = -INFINITY,
+		.string_exist = true,
+	};
+
+	const char expect[] = "{\"null\":null,\"string\":\"-Infinity\"}";
+	char actual[sizeof(expect)];
+	struct bo_json_simple_writer writer;
+	struct bo_json_error err;
+
+	bo_json_simple_writer_init(&writer, actual, sizeof(actual));
+	err = bo_json_encode(&input, &doubles_desc, &writer.ctx);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	TEST_ASSERT_EQUAL_STRING_LEN(expect, actual, strlen(expect));
+
+	input.string = NAN;
+	bo_json_simple_writer_init(&writer, actual, sizeof(actual));
+	err = bo_json_encode(&input, &doubles_desc, &writer.ctx);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	TEST_ASSERT_EQUAL_STRING_LEN("{\"null\":null,\"string\":\"NaN\"}", actual, writer.len);
+
+	// without a policy a non-finite value cannot be encoded
+	input.error = NAN;
+	input.error_exist = true;
+	bo_json_simple_writer_init(&writer, actual, sizeof(actual));
+	err = bo_json_encode(&input, &doubles_desc, &writer.ctx);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_CONVERT, err.err);
+}
+
+void test_encode_double_fixed(void)
+{
+	const struct {
+		double input;
+		unsigned int decimals;
+		const char *expect;
+	} cases[] = {
+		{2.5, 2, "2.50"},
+		{19.99, 2, "19.99"},
+		{1234.5678, 2, "1234.57"},
+		{-1234.5678, 3, "-1234.568"},
+		{0.5, 0, "1"},
+		{-0.5, 0, "-1"},
+		{0.0001, 4, "0.0001"},
+		{0.000001, 9, "0.000001000"},
+		{-0.001, 2, "0.00"},
+		{-0.0, 1, "0.0"},
+		{0.125, 9, "0.125000000"},
+		{-9.2e15, 3, "-9200000000000000.000"},
+		// adding 0.5 before truncating would round these
+		{0.49999999999999994, 0, "0"},
+		{-0.49999999999999994, 0, "0"},
+		{4503599627370497.0, 0, "4503599627370497"},
+		{450359962737049.7, 1, "450359962737049.7"},
+		// scaling by 10^decimals would round these, past 2^53 or to a tie
+		{4503599627370497.0, 1, "4503599627370497.0"},
+		{4503599627370497.0, 3, "4503599627370497.000"},
+		{-4503599627370497.0, 2, "-4503599627370497.00"},
+		{2251799813685248.5, 1, "2251799813685248.5"},
+		{2251799813685248.5, 0, "2251799813685249"},
+		{0.045, 2, "0.04"},
+		{1.005, 2, "1.00"},
+		{0.9999999999, 9, "1.000000000"},
+		{6e-10, 9, "0.000000001"},
+		{-1e-300, 9, "0.000000000"},
+		// too large for the scaled integer, written like any other double
+		{1e17, 2, "100000000000000000"},
+		{4503599627370497.0, 4, "4503599627370497"},
+		{-1.5e300, 9, "-1.5e300"},
+	};
+
+	for (size_t i = 0; i < BO_ARRAY_SIZE(cases); i++) {
+		const struct bo_json_value_desc desc = {
+			.type = BO_JSON_VALUE_TYPE_DOUBLE,
+			.flags = BO_JSON_FLAGS_FIXED_DECIMALS,
+			.number = {.decimals = cases[i].decimals},
+		};
+		char actual[BO_JSON_MAX_SIZE_DOUBLE];
+		struct bo_json_simple_writer writer;
+		struct bo_json_encoder encoder;
+		size_t size;
+		size_t written;
+
+		sprintf(error_message, "case %zu", i);
+
+		bo_json_simple_writer_init(&writer, actual, sizeof(actual));
+		struct bo_json_error err = bo_json_encode(&cases[i].input, &desc, &writer.ctx);
+		TEST_ASSERT_EQUAL_MESSAGE(BO_JSON_ERROR_NONE, err.err, error_message);
+		TEST_ASSERT_EQUAL_MESSAGE(strlen(cases[i].expect), writer.len, error_message);
+		TEST_ASSERT_EQUAL_STRING_LEN_MESSAGE(cases[i].expect, actual, writer.len,
+						     error_message);
+
+		err = bo_json_encoded_size(&cases[i].input, &desc, &size);
+		TEST_ASSERT_EQUAL_MESSAGE(BO_JSON_ERROR_NONE, err.err, error_message);
+		TEST_ASSERT_EQUAL_MESSAGE(writer.len, size, error_message);
+
+		bo_json_encoder_init(&encoder, &cases[i].input, &desc);
+		err = bo_json_encoder_step(&encoder, actual, sizeof(actual), &written);
+		TEST_ASSERT_EQUAL_MESSAGE(BO_JSON_ERROR_NONE, err.err, error_message);
+		TEST_ASSERT_EQUAL_STRING_LEN_MESSAGE(cases[i].expect, actual, written,
+						     error_message);
+	}
+
+	struct prices {
+		double price;
+		bool price_exist;
+		double ratio;
+		bool ratio_exist;
+	} input = {.price = 3.14159, .price_exist = true, .ratio = 0.1, .ratio_exist = true};
+
+	const struct bo_json_obj_attr_desc prices_attrs[] = {
+		BO_JSON_OBJECT_ATTR_DOUBLE_FIXED(struct prices, price, 2),
+		BO_JSON_OBJECT_ATTR_DOUBLE(struct prices, ratio),
+	};
+	const struct bo_json_value_desc prices_desc = BO_JSON_VALUE_OBJECT(prices_attrs);
+	const char expect[] = "{\"price\":3.14,\"ratio\":0.1}";
+	char actual[64];
+	struct bo_json_simple_writer writer;
+
+	bo_json_simple_writer_init(&writer, actual, sizeof(actual));
+	struct bo_json_error err = bo_json_encode(&input, &prices_desc, &writer.ctx);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	TEST_ASSERT_EQUAL(strlen(expect), writer.len);
+	TEST_ASSERT_EQUAL_STRING_LEN(expect, actual, writer.len);
+}
+
 void test_encode_cstr(void)
 {
 	const struct {
@@ -118,6 +465,83 @@ void test_encode_cstr(void)
 	}
 }
 
+// reference escaping, one character at a time
+static size_t escape_reference(const char *in, size_t in_len, char *out)
+{
+	char *p = out;
+
+	*p++ = '"';
+	for (size_t i = 0; i < in_len && in[i] != '\0'; i++) {
+		const unsigned char c = (unsigned char)in[i];
+
+		if (c == '"' || c == '\\') {
+			p += sprintf(p, "\\%c", c);
+		} else if (c == '\n') {
+			p += sprintf(p, "\\n");
+		} else if (c == '\t') {
+			p += sprintf(p, "\\t");
+		} else if (c == '\r') {
+			p += sprintf(p, "\\r");
+		} else if (c == '\b') {
+			p += sprintf(p, "\\b");
+		} else if (c == '\f') {
+			p += sprintf(p, "\\f");
+		} else if (c < 0x20) {
+			p += sprintf(p, "\\u%04x", c);
+		} else {
+			*p++ = (char)c;
+		}
+	}
+	*p++ = '"';
+
+	return (size_t)(p - out);
+}
+
+void test_encode_cstr_escape(void)
+{
+	static const char specials[] = {'"', '\\', '\n', '\x01', '\x1f', '\x7f', '\x80', '\xff'};
+
+	struct bo_json_simple_writer writer;
+	char input[48];
+	char expect[48 * 6 + 2];
+	char actual[48 * 6 + 2];
+
+	// every special character at every position of a long clean string, so it lands in
+	// each lane of the block scan and in the tail
+	for (size_t s = 0; s < BO_ARRAY_SIZE(specials); s++) {
+		for (size_t pos = 0; pos < sizeof(input) - 1; pos++) {
+			sprintf(error_message, "special[%zu] at %zu", s, pos);
+
+			memset(input, 'a', sizeof(input) - 1);
+			input[sizeof(input) - 1] = '\0';
+			input[pos] = specials[s];
+
+			const struct bo_json_value_desc cstr_desc =
+				BO_JSON_VALUE_CSTR(sizeof(input));
+			const size_t expect_len =
+				escape_reference(input, sizeof(input), expect);
+
+			bo_json_simple_writer_init(&writer, actual, sizeof(actual));
+			struct bo_json_error err =
+				bo_json_encode(input, &cstr_desc, &writer.ctx);
+
+			TEST_ASSERT_EQUAL_MESSAGE(BO_JSON_ERROR_NONE, err.err, error_message);
+			TEST_ASSERT_EQUAL_MESSAGE(expect_len, writer.len, error_message);
+			TEST_ASSERT_EQUAL_STRING_LEN_MESSAGE(expect, actual, expect_len,
+							     error_message);
+		}
+	}
+
+	// the encoder stops at the capacity when the terminator is missing
+	const char unterminated[4] = {'a', 'b', '\x02', 'c'};
+	const struct bo_json_value_desc cstr_desc = BO_JSON_VALUE_CSTR(sizeof(unterminated));
+
+	bo_json_simple_writer_init(&writer, actual, sizeof(actual));
+	struct bo_json_error err = bo_json_encode(unterminated, &cstr_desc, &writer.ctx);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	TEST_ASSERT_EQUAL_STRING_LEN("\"ab\\u0002c\"", actual, writer.len);
+}
+
 struct prims {
 	bool f;
 	bool f_exist;
@@ -212,6 +636,78 @@ void test_encode_object_primitive_types(void)
 	TEST_ASSERT_EQUAL_STRING_LEN(expect, actual, strlen(expect));
 }
 
+struct keys {
+	int plain;
+	bool plain_exist;
+
+	int quoted;
+	bool quoted_exist;
+
+	int runtime;
+	bool runtime_exist;
+};
+
+static const struct bo_json_obj_attr_desc keys_attrs[] = {
+	BO_JSON_OBJECT_ATTR_INT(struct keys, plain),
+	BO_JSON_OBJECT_ATTR_INT_NAMED(struct keys, quoted, "a\"b\\c\n"),
+	// an attribute written without the macros has no precomputed key
+	{
+		.name = "runtime",
+		.exist_offset = offsetof(struct keys, runtime_exist),
+		.desc = BO_JSON_VALUE_INT_EXT(offsetof(struct keys, runtime), 0,
+					      BO_JSON_FLAGS_NONE),
+	},
+};
+
+static const struct bo_json_value_desc keys_desc = BO_JSON_VALUE_OBJECT(keys_attrs);
+
+void test_encode_object_key(void)
+{
+	const struct {
+		struct keys input;
+		const char *expect;
+	} cases[] = {
+		{{1, true, 2, true, 3, true}, "{\"plain\":1,\"a\\\"b\\\\c\\n\":2,\"runtime\":3}"},
+		{{1, false, 2, true, 3, true}, "{\"a\\\"b\\\\c\\n\":2,\"runtime\":3}"},
+		{{1, false, 2, false, 3, true}, "{\"runtime\":3}"},
+		{{1, true, 2, false, 3, false}, "{\"plain\":1}"},
+	};
+
+	for (size_t i = 0; i < BO_ARRAY_SIZE(cases); i++) {
+		char actual[64];
+		struct bo_json_simple_writer writer;
+
+		sprintf(error_message, "case %zu", i);
+
+		bo_json_simple_writer_init(&writer, actual, sizeof(actual));
+		struct bo_json_error err = bo_json_encode(&cases[i].input, &keys_desc, &writer.ctx);
+		TEST_ASSERT_EQUAL_MESSAGE(BO_JSON_ERROR_NONE, err.err, error_message);
+		TEST_ASSERT_EQUAL_MESSAGE(strlen(cases[i].expect), writer.len, error_message);
+		TEST_ASSERT_EQUAL_STRING_LEN_MESSAGE(cases[i].expect, actual, writer.len,
+						     error_message);
+	}
+
+	// names that are not literals are escaped at encode time, even when their spelling is as
+	// long as a literal's would be
+	static const char label[4] = "tag";
+	const char *attr_name = "ptr";
+	const struct bo_json_obj_attr_desc named_attrs[] = {
+		BO_JSON_OBJECT_ATTR_INT_NAMED(struct keys, plain, label),
+		BO_JSON_OBJECT_ATTR_INT_NAMED(struct keys, quoted, attr_name),
+	};
+	const struct bo_json_value_desc named_desc = BO_JSON_VALUE_OBJECT(named_attrs);
+	const struct keys input = {1, true, 2, true, 3, true};
+	const char expect[] = "{\"tag\":1,\"ptr\":2}";
+	char actual[64];
+	struct bo_json_simple_writer writer;
+
+	bo_json_simple_writer_init(&writer, actual, sizeof(actual));
+	struct bo_json_error err = bo_json_encode(&input, &named_desc, &writer.ctx);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	TEST_ASSERT_EQUAL(strlen(expect), writer.len);
+	TEST_ASSERT_EQUAL_STRING_LEN(expect, actual, writer.len);
+}
+
 void test_encode_array_bool(void)
 {
 	struct array_boolean {
@@ -463,3 +959,1559 @@ void test_encode_object_nest(void)
 	// check value
 	TEST_ASSERT_EQUAL_STRING_LEN(expect, actual, strlen(expect));
 }
+
+struct counting_writer {
+	struct bo_json_writer ctx;
+	struct bo_json_simple_writer simple;
+	size_t n_writes;
+};
+
+static struct bo_json_error counting_write(struct bo_json_writer *writer, const void *data,
+					   size_t len)
+{
+	struct counting_writer *cwriter = (struct counting_writer *)writer;
+
+	cwriter->n_writes++;
+	return bo_json_writer_write(&cwriter->simple.ctx, data, len);
+}
+
+void test_encode_buffered_writer(void)
+{
+	struct array_ints {
+		int ints[64];
+		size_t ints_count;
+	} input = {.ints_count = 64};
+
+	const struct bo_json_value_desc array_desc = BO_JSON_VALUE_STRUCT_ARRAY(
+		struct array_ints, ints, &bo_json_int_desc, 64, ints_count);
+
+	for (size_t i = 0; i < input.ints_count; i++) {
+		input.ints[i] = (int)(i * i) - 1000;
+	}
+
+	char expect[512];
+	char actual[512];
+	char buf[16];
+
+	struct bo_json_simple_writer simple;
+	struct counting_writer counting;
+	struct bo_json_buffered_writer writer;
+	struct bo_json_error err;
+
+	bo_json_simple_writer_init(&simple, expect, sizeof(expect));
+	err = bo_json_encode(&input, &array_desc, &simple.ctx);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+
+	bo_json_writer_init(&counting.ctx, counting_write);
+	bo_json_simple_writer_init(&counting.simple, actual, sizeof(actual));
+	counting.n_writes = 0;
+
+	bo_json_buffered_writer_init(&writer, &counting.ctx, buf, sizeof(buf));
+	err = bo_json_encode(&input, &array_desc, &writer.ctx);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	err = bo_json_buffered_writer_flush(&writer);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+
+	// same output, passed on in buffer sized pieces
+	TEST_ASSERT_EQUAL(simple.len, counting.simple.len);
+	TEST_ASSERT_EQUAL_STRING_LEN(expect, actual, simple.len);
+	TEST_ASSERT_TRUE(counting.n_writes <= (simple.len / (sizeof(buf) - 8)) + 1);
+
+	// errors of the wrapped writer are reported
+	bo_json_simple_writer_init(&counting.simple, actual, 100);
+	bo_json_buffered_writer_init(&writer, &counting.ctx, buf, sizeof(buf));
+	err = bo_json_encode(&input, &array_desc, &writer.ctx);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_INSUFFICIENT_SPACE, err.err);
+}
+
+void test_encode_write_only_writer(void)
+{
+	const char *expect = "{\"t\":true,\"positive_int\":123,\"str\":\"boring json\"}";
+	struct prims input = {
+		.t = true,
+		.t_exist = true,
+		.positive_int = 123,
+		.positive_int_exist = true,
+		.str = "boring json",
+		.str_exist = true,
+	};
+	char actual[128];
+
+	struct counting_writer counting;
+	struct bo_json_error err;
+
+	// a writer which only sets write, the optional members hold whatever was there before
+	memset(&counting.ctx, 0xa5, sizeof(counting.ctx));
+	counting.ctx.write = counting_write;
+	bo_json_simple_writer_init(&counting.simple, actual, sizeof(actual));
+	counting.n_writes = 0;
+
+	err = bo_json_encode(&input, &prims_desc, &counting.ctx);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	TEST_ASSERT_EQUAL(strlen(expect), counting.simple.len);
+	TEST_ASSERT_EQUAL_STRING_LEN(expect, actual, counting.simple.len);
+	TEST_ASSERT_TRUE(counting.n_writes > 0);
+
+	// a copy of an initialized writer only uses write as well
+	struct bo_json_simple_writer simple;
+	char buf[128];
+
+	bo_json_simple_writer_init(&simple, buf, sizeof(buf));
+	counting.ctx = simple.ctx;
+	counting.ctx.write = counting_write;
+	counting.n_writes = 0;
+	TEST_ASSERT_NULL(bo_json_writer_reserve(&counting.ctx, 8));
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, bo_json_writer_write(&counting.ctx, "[]", 2).err);
+	TEST_ASSERT_EQUAL(1, counting.n_writes);
+}
+
+struct reserving_writer {
+	struct bo_json_writer ctx;
+	struct bo_json_simple_writer simple;
+	char *reserved;
+	size_t n_writes;
+	size_t n_commits;
+};
+
+static struct bo_json_error reserving_write(struct bo_json_writer *writer, const void *data,
+					    size_t len)
+{
+	struct reserving_writer *rwriter = (struct reserving_writer *)writer;
+
+	rwriter->n_writes++;
+	return bo_json_writer_write(&rwriter->simple.ctx, data, len);
+}
+
+static char *reserving_reserve(struct bo_json_writer *writer, size_t len)
+{
+	struct reserving_writer *rwriter = (struct reserving_writer *)writer;
+
+	rwriter->reserved = bo_json_writer_reserve(&rwriter->simple.ctx, len);
+	return rwriter->reserved;
+}
+
+static void reserving_commit(struct bo_json_writer *writer, size_t len)
+{
+	struct reserving_writer *rwriter = (struct reserving_writer *)writer;
+
+	rwriter->n_commits++;
+	bo_json_writer_commit(&rwriter->simple.ctx, rwriter->reserved, len);
+}
+
+void test_encode_reserve(void)
+{
+	struct numbers {
+		int ints[4];
+		bool ints_exist;
+		size_t ints_count;
+
+		double doubles[4];
+		bool doubles_exist;
+		size_t doubles_count;
+	};
+
+	const struct bo_json_obj_attr_desc numbers_attrs[] = {
+		BO_JSON_OBJECT_ATTR_ARRAY(struct numbers, ints, &bo_json_int_desc, 4, ints_count),
+		BO_JSON_OBJECT_ATTR_ARRAY(struct numbers, doubles, &bo_json_double_desc, 4,
+					  doubles_count),
+	};
+	const struct bo_json_value_desc numbers_desc = BO_JSON_VALUE_OBJECT(numbers_attrs);
+
+	const struct numbers input = {
+		.ints = {0, -1, INT_MAX, INT_MIN},
+		.ints_exist = true,
+		.ints_count = 4,
+		.doubles = {0.1, -2.5e-300, 1e21, 123456.789},
+		.doubles_exist = true,
+		.doubles_count = 4,
+	};
+	const char expect[] = "{\"ints\":[0,-1,2147483647,-2147483648],"
+			      "\"doubles\":[0.1,-2.5e-300,1e21,123456.789]}";
+
+	char actual[256];
+	struct reserving_writer writer;
+	struct bo_json_error err;
+
+	// numbers are formatted in the reserved memory, only the rest goes through write
+	bo_json_writer_init(&writer.ctx, reserving_write);
+	writer.ctx.reserve = reserving_reserve;
+	writer.ctx.commit = reserving_commit;
+	bo_json_simple_writer_init(&writer.simple, actual, sizeof(actual));
+	writer.n_writes = 0;
+	writer.n_commits = 0;
+
+	err = bo_json_encode(&input, &numbers_desc, &writer.ctx);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	TEST_ASSERT_EQUAL_STRING_LEN(expect, actual, writer.simple.len);
+	TEST_ASSERT_EQUAL(strlen(expect), writer.simple.len);
+	TEST_ASSERT_EQUAL(8, writer.n_commits);
+
+	// without room to reserve, numbers fall back to write
+	writer.n_writes = 0;
+	writer.n_commits = 0;
+	bo_json_simple_writer_init(&writer.simple, actual, strlen(expect));
+
+	err = bo_json_encode(&input, &numbers_desc, &writer.ctx);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	TEST_ASSERT_EQUAL_STRING_LEN(expect, actual, writer.simple.len);
+	TEST_ASSERT_TRUE(writer.n_commits < 8);
+
+	// the memory writer grows to make room
+	struct bo_json_mem_writer mem;
+
+	bo_json_mem_writer_init(&mem, 16, 1024);
+	err = bo_json_encode(&input, &numbers_desc, &mem.ctx);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	TEST_ASSERT_EQUAL(strlen(expect), mem.len);
+	TEST_ASSERT_EQUAL_STRING_LEN(expect, mem.buf, mem.len);
+	bo_json_mem_writer_cleanup(&mem);
+}
+
+struct counting_alloc {
+	struct bo_json_allocator alloc;
+	int n_resizes;
+	int n_releases;
+};
+
+static void *counting_resize(void *ctx, void *ptr, size_t size)
+{
+	struct counting_alloc *counting = ctx;
+
+	counting->n_resizes++;
+	return realloc(ptr, size);
+}
+
+static void counting_release(void *ctx, void *ptr)
+{
+	struct counting_alloc *counting = ctx;
+
+	counting->n_releases++;
+	free(ptr);
+}
+
+void test_encode_mem_writer(void)
+{
+	struct text {
+		char str[4096];
+	};
+
+	const struct bo_json_value_desc text_desc =
+		BO_JSON_VALUE_STRUCT_CSTR_ARRAY(struct text, str);
+
+	static struct text input;
+	struct counting_alloc counting = {
+		.alloc = {.resize = counting_resize, .release = counting_release},
+	};
+	struct bo_json_mem_writer mem;
+	struct bo_json_error err;
+	void *buf;
+
+	memset(input.str, 'a', sizeof(input.str) - 1);
+	counting.alloc.ctx = &counting;
+
+	// the buffer doubles, 4 KiB of output does not cost one allocation per 16 bytes
+	bo_json_mem_writer_init_alloc(&mem, 16, 1 << 20, &counting.alloc);
+	err = bo_json_encode(&input, &text_desc, &mem.ctx);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	TEST_ASSERT_EQUAL(sizeof(input.str) + 1, mem.len);
+	TEST_ASSERT_TRUE(counting.n_resizes <= 10);
+
+	// a reset writer encodes again without allocating
+	counting.n_resizes = 0;
+	bo_json_mem_writer_reset(&mem);
+	err = bo_json_encode(&input, &text_desc, &mem.ctx);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	TEST_ASSERT_EQUAL(sizeof(input.str) + 1, mem.len);
+	TEST_ASSERT_EQUAL(0, counting.n_resizes);
+	bo_json_mem_writer_cleanup(&mem);
+	TEST_ASSERT_EQUAL(1, counting.n_releases);
+
+	// reserving up front costs exactly one allocation
+	counting.n_resizes = 0;
+	bo_json_mem_writer_init_alloc(&mem, 16, 1 << 20, &counting.alloc);
+	err = bo_json_mem_writer_reserve(&mem, sizeof(input.str) + 1);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	err = bo_json_encode(&input, &text_desc, &mem.ctx);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	TEST_ASSERT_EQUAL(1, counting.n_resizes);
+	bo_json_mem_writer_cleanup(&mem);
+
+	// growth stops at max_cap, but may reach it exactly
+	bo_json_mem_writer_init(&mem, 16, sizeof(input.str));
+	err = bo_json_encode(&input, &text_desc, &mem.ctx);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_INSUFFICIENT_SPACE, err.err);
+	bo_json_mem_writer_cleanup(&mem);
+	bo_json_mem_writer_init(&mem, 16, sizeof(input.str) + 1);
+	err = bo_json_encode(&input, &text_desc, &mem.ctx);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	TEST_ASSERT_EQUAL(sizeof(input.str) + 1, mem.cap);
+	bo_json_mem_writer_cleanup(&mem);
+
+#if BO_JSON_MEM_WRITER_POOL_SIZE > 0
+	// a released buffer is handed to the next writer of the thread
+	bo_json_mem_writer_acquire(&mem, 16, 1 << 20);
+	err = bo_json_encode(&input, &text_desc, &mem.ctx);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	buf = mem.buf;
+	bo_json_mem_writer_release(&mem);
+	TEST_ASSERT_NULL(mem.buf);
+
+	bo_json_mem_writer_acquire(&mem, 16, 1 << 20);
+	TEST_ASSERT_EQUAL_PTR(buf, mem.buf);
+	TEST_ASSERT_EQUAL(0, mem.len);
+	err = bo_json_encode(&input, &text_desc, &mem.ctx);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	TEST_ASSERT_EQUAL_PTR(buf, mem.buf);
+	TEST_ASSERT_EQUAL_STRING_LEN("\"aaaa", mem.buf, 5);
+	bo_json_mem_writer_release(&mem);
+
+	// but not to one that may not grow that large
+	bo_json_mem_writer_acquire(&mem, 16, 64);
+	TEST_ASSERT_NULL(mem.buf);
+	bo_json_mem_writer_cleanup(&mem);
+#else
+	(void)buf;
+#endif
+	bo_json_mem_writer_pool_drain();
+}
+
+void test_encode_iovec_writer(void)
+{
+	struct texts {
+		char strs[16][128];
+		size_t strs_count;
+	};
+
+	static struct texts input = {.strs_count = 16};
+	static const struct bo_json_value_desc str_desc = BO_JSON_VALUE_CSTR(128);
+	const struct bo_json_value_desc array_desc =
+		BO_JSON_VALUE_STRUCT_ARRAY(struct texts, strs, &str_desc, 16, strs_count);
+
+	// long clean runs are referenced, short ones and escapes are copied
+	for (size_t i = 0; i < input.strs_count; i++) {
+		memset(input.strs[i], 'a' + (char)i, (i * 8) % 127);
+		input.strs[i][(i * 8) % 127] = '\0';
+		if (i % 3 == 0) {
+			input.strs[i][i] = '"';
+		}
+	}
+
+	static char expect[16 * 130 + 16];
+	static char actual[sizeof(expect)];
+	struct bo_json_simple_writer simple;
+	struct bo_json_error err;
+
+	bo_json_simple_writer_init(&simple, expect, sizeof(expect));
+	err = bo_json_encode(&input, &array_desc, &simple.ctx);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+
+	// a roomy writer, then one flushing all the time
+	const size_t geometries[][2] = {{64, 256}, {2, 16}, {3, 1}};
+
+	for (size_t g = 0; g < BO_ARRAY_SIZE(geometries); g++) {
+		struct iovec iov[64];
+		char buf[256];
+		int fds[2];
+		struct bo_json_iovec_writer writer;
+
+		sprintf(error_message, "iov %zu buf %zu", geometries[g][0], geometries[g][1]);
+		TEST_ASSERT_EQUAL(0, pipe(fds));
+
+		bo_json_iovec_writer_init(&writer, fds[1], iov, geometries[g][0], buf,
+					  geometries[g][1]);
+		err = bo_json_encode(&input, &array_desc, &writer.ctx);
+		TEST_ASSERT_EQUAL_MESSAGE(BO_JSON_ERROR_NONE, err.err, error_message);
+
+		if (g == 0) {
+			// nothing written yet, the longest string is referenced in place
+			bool referenced = false;
+
+			for (size_t i = 0; i < writer.iov_len; i++) {
+				referenced |= (writer.iov[i].iov_base == (void *)input.strs[14]);
+			}
+			TEST_ASSERT_TRUE(referenced);
+		}
+
+		err = bo_json_iovec_writer_flush(&writer);
+		TEST_ASSERT_EQUAL_MESSAGE(BO_JSON_ERROR_NONE, err.err, error_message);
+		close(fds[1]);
+
+		size_t len = 0;
+		ssize_t ret;
+
+		while ((ret = read(fds[0], actual + len, sizeof(actual) - len)) > 0) {
+			len += (size_t)ret;
+		}
+		close(fds[0]);
+
+		TEST_ASSERT_EQUAL_MESSAGE(simple.len, len, error_message);
+		TEST_ASSERT_EQUAL_STRING_LEN_MESSAGE(expect, actual, len, error_message);
+	}
+
+	// errors of writev are reported
+	struct iovec iov[4];
+	char buf[16];
+	struct bo_json_iovec_writer writer;
+
+	bo_json_iovec_writer_init(&writer, -1, iov, BO_ARRAY_SIZE(iov), buf, sizeof(buf));
+	err = bo_json_encode(&input, &array_desc, &writer.ctx);
+	if (err.err == BO_JSON_ERROR_NONE) {
+		err = bo_json_iovec_writer_flush(&writer);
+	}
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_IO, err.err);
+}
+
+struct pipe_reader {
+	int fd;
+	char *buf;
+	size_t cap;
+	size_t len;
+};
+
+static void *read_pipe(void *arg)
+{
+	struct pipe_reader *reader = arg;
+	ssize_t ret;
+
+	while ((ret = read(reader->fd, reader->buf + reader->len, reader->cap - reader->len)) > 0) {
+		reader->len += (size_t)ret;
+	}
+
+	return NULL;
+}
+
+void test_encode_fd_writer(void)
+{
+	struct doubles {
+		double values[8192];
+		size_t values_count;
+	};
+
+	static struct doubles input = {.values_count = 8192};
+	const struct bo_json_value_desc array_desc = BO_JSON_VALUE_STRUCT_ARRAY(
+		struct doubles, values, &bo_json_double_desc, 8192, values_count);
+
+	for (size_t i = 0; i < input.values_count; i++) {
+		input.values[i] = (double)i / 7.0;
+	}
+
+	// more than a pipe holds, the reader runs alongside
+	static char expect[8192 * 26];
+	static char actual[sizeof(expect)];
+	static char buf[8 * 4096];
+	struct bo_json_simple_writer simple;
+	struct bo_json_error err;
+
+	bo_json_simple_writer_init(&simple, expect, sizeof(expect));
+	err = bo_json_encode(&input, &array_desc, &simple.ctx);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+
+	const size_t geometries[][2] = {{2, 4096}, {1, 64}, {8, 7}};
+
+	for (size_t g = 0; g < BO_ARRAY_SIZE(geometries); g++) {
+		struct bo_json_fd_writer writer;
+		struct pipe_reader reader = {.buf = actual, .cap = sizeof(actual)};
+		pthread_t thread;
+		int fds[2];
+
+		sprintf(error_message, "%zu buffers of %zu", geometries[g][0], geometries[g][1]);
+		TEST_ASSERT_EQUAL(0, pipe(fds));
+		reader.fd = fds[0];
+		TEST_ASSERT_EQUAL(0, pthread_create(&thread, NULL, read_pipe, &reader));
+
+		err = bo_json_fd_writer_init(&writer, fds[1], buf, geometries[g][1],
+					     geometries[g][0]);
+		TEST_ASSERT_EQUAL_MESSAGE(BO_JSON_ERROR_NONE, err.err, error_message);
+		err = bo_json_encode(&input, &array_desc, &writer.ctx);
+		TEST_ASSERT_EQUAL_MESSAGE(BO_JSON_ERROR_NONE, err.err, error_message);
+		err = bo_json_fd_writer_cleanup(&writer);
+		TEST_ASSERT_EQUAL_MESSAGE(BO_JSON_ERROR_NONE, err.err, error_message);
+
+		close(fds[1]);
+		pthread_join(thread, NULL);
+		close(fds[0]);
+
+		TEST_ASSERT_EQUAL_MESSAGE(simple.len, reader.len, error_message);
+		TEST_ASSERT_EQUAL_STRING_LEN_MESSAGE(expect, actual, reader.len, error_message);
+	}
+
+	// errors of write are reported
+	struct bo_json_fd_writer writer;
+
+	err = bo_json_fd_writer_init(&writer, -1, buf, 64, 2);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	err = bo_json_encode(&input, &array_desc, &writer.ctx);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_IO, err.err);
+	err = bo_json_fd_writer_cleanup(&writer);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_IO, err.err);
+
+	err = bo_json_fd_writer_init(&writer, -1, buf, 64, BO_JSON_FD_WRITER_MAX_BUFS + 1);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NOT_SUPPORT, err.err);
+}
+
+// the size computed up front is what the encoder then writes
+static void check_encoded_size(const void *input, const struct bo_json_value_desc *desc)
+{
+	static char actual[16384];
+	struct bo_json_simple_writer writer;
+	struct bo_json_error err;
+	size_t size = 0;
+
+	bo_json_simple_writer_init(&writer, actual, sizeof(actual));
+	err = bo_json_encode(input, desc, &writer.ctx);
+	TEST_ASSERT_EQUAL_MESSAGE(BO_JSON_ERROR_NONE, err.err, error_message);
+
+	err = bo_json_encoded_size(input, desc, &size);
+	TEST_ASSERT_EQUAL_MESSAGE(BO_JSON_ERROR_NONE, err.err, error_message);
+	TEST_ASSERT_EQUAL_MESSAGE(writer.len, size, error_message);
+}
+
+void test_encode_encoded_size(void)
+{
+	struct sized {
+		int64_t int64s[8];
+		bool int64s_exist;
+		size_t int64s_count;
+
+		double doubles[256];
+		bool doubles_exist;
+		size_t doubles_count;
+
+		double nonfinite;
+		bool nonfinite_exist;
+
+		char str[40];
+		bool str_exist;
+	};
+
+	static const struct bo_json_value_desc int64_desc = BO_JSON_VALUE_INT64();
+	static const struct bo_json_obj_attr_desc sized_attrs[] = {
+		BO_JSON_OBJECT_ATTR_ARRAY(struct sized, int64s, &int64_desc, 8, int64s_count),
+		BO_JSON_OBJECT_ATTR_ARRAY(struct sized, doubles, &bo_json_double_desc, 256,
+					  doubles_count),
+		BO_JSON_OBJECT_ATTR_DOUBLE_NONFINITE(struct sized, nonfinite,
+						     BO_JSON_FLAGS_NONFINITE_STRING),
+		BO_JSON_OBJECT_ATTR_CSTR_ARRAY_NAMED(struct sized, str, "s\"tr"),
+	};
+	static const struct bo_json_value_desc sized_desc = BO_JSON_VALUE_OBJECT(sized_attrs);
+
+	static struct sized input = {
+		.int64s = {0, 9, 10, -1, INT64_MAX, INT64_MIN, 1000000, -99},
+		.int64s_count = 8,
+		.nonfinite = -INFINITY,
+		.str = "tab\there \"quoted\" \x01 and \\",
+	};
+	uint64_t state = 0x9E3779B97F4A7C15ULL;
+
+	input.doubles_count = BO_ARRAY_SIZE(input.doubles);
+	for (size_t i = 0; i < input.doubles_count; i++) {
+		do {
+			state ^= state << 13;
+			state ^= state >> 7;
+			state ^= state << 17;
+			memcpy(&input.doubles[i], &state, sizeof(double));
+		} while (!isfinite(input.doubles[i]));
+	}
+	input.doubles[0] = 0.0;
+	input.doubles[1] = -0.0;
+	input.doubles[2] = 1e21;
+	input.doubles[3] = 1e-7;
+	input.doubles[4] = 123456789012345680000.0;
+	input.doubles[5] = 0.000001;
+
+	// every combination of present attributes
+	for (unsigned int present = 0; present < 16; present++) {
+		sprintf(error_message, "present %u", present);
+		input.int64s_exist = (present & 1) != 0;
+		input.doubles_exist = (present & 2) != 0;
+		input.nonfinite_exist = (present & 4) != 0;
+		input.str_exist = (present & 8) != 0;
+		check_encoded_size(&input, &sized_desc);
+	}
+
+	sprintf(error_message, "empty array");
+	input.int64s_count = 0;
+	check_encoded_size(&input, &sized_desc);
+
+	sprintf(error_message, "prims");
+	const struct prims prims_input = {
+		.t = true,
+		.t_exist = true,
+		.f_exist = true,
+		.str = "boring json",
+		.str_exist = true,
+		.arr_integer = {0, 1, -1},
+		.arr_integer_count = 3,
+		.arr_integer_exist = true,
+	};
+	check_encoded_size(&prims_input, &prims_desc);
+
+	// the errors of the encoder are reported
+	size_t size;
+	input.nonfinite = NAN;
+	input.doubles[0] = NAN;
+	struct bo_json_error err = bo_json_encoded_size(&input, &sized_desc, &size);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_CONVERT, err.err);
+}
+
+struct worst {
+	bool b;
+	bool b_exist;
+
+	int i;
+	bool i_exist;
+
+	int64_t l;
+	bool l_exist;
+
+	double d;
+	bool d_exist;
+
+	char s[8];
+	bool s_exist;
+
+	int arr[3];
+	bool arr_exist;
+	size_t arr_count;
+};
+
+static const struct bo_json_obj_attr_desc worst_attrs[] = {
+	BO_JSON_OBJECT_ATTR_BOOL(struct worst, b),
+	BO_JSON_OBJECT_ATTR_INT(struct worst, i),
+	BO_JSON_OBJECT_ATTR_INT64(struct worst, l),
+	BO_JSON_OBJECT_ATTR_DOUBLE(struct worst, d),
+	BO_JSON_OBJECT_ATTR_CSTR_ARRAY(struct worst, s),
+	BO_JSON_OBJECT_ATTR_ARRAY(struct worst, arr, &bo_json_int_desc, 3, arr_count),
+};
+
+static const struct bo_json_value_desc worst_desc = BO_JSON_VALUE_OBJECT(worst_attrs);
+
+// clang-format off
+#define WORST_MAX_SIZE BO_JSON_MAX_SIZE_OBJECT(                                                    \
+	BO_JSON_MAX_SIZE_ATTR("b", BO_JSON_MAX_SIZE_BOOL) +                                        \
+	BO_JSON_MAX_SIZE_ATTR("i", BO_JSON_MAX_SIZE_INT) +                                         \
+	BO_JSON_MAX_SIZE_ATTR("l", BO_JSON_MAX_SIZE_INT64) +                                       \
+	BO_JSON_MAX_SIZE_ATTR("d", BO_JSON_MAX_SIZE_DOUBLE) +                                      \
+	BO_JSON_MAX_SIZE_ATTR("s", BO_JSON_MAX_SIZE_CSTR(8)) +                                     \
+	BO_JSON_MAX_SIZE_ATTR("arr", BO_JSON_MAX_SIZE_ARRAY(3, BO_JSON_MAX_SIZE_INT)))
+// clang-format on
+
+void test_encode_max_encoded_size(void)
+{
+	// usable to size a static buffer
+	static char actual[WORST_MAX_SIZE];
+
+	struct bo_json_simple_writer writer;
+	struct bo_json_error err;
+	size_t max_size = 0;
+
+	err = bo_json_max_encoded_size(&worst_desc, &max_size);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	TEST_ASSERT_EQUAL(WORST_MAX_SIZE, max_size);
+
+	// a double which needs all 17 digits and the longest layout
+	double d = -1e-6;
+	char str[32];
+	size_t len = 0;
+
+	while (len < BO_JSON_MAX_SIZE_DOUBLE) {
+		uint64_t bits;
+
+		// the next double away from zero
+		memcpy(&bits, &d, sizeof(bits));
+		bits++;
+		memcpy(&d, &bits, sizeof(d));
+		TEST_ASSERT_TRUE(encode_decode_double(d, &d, str, &len));
+	}
+
+	// the largest value of every attribute fills the buffer exactly
+	struct worst input = {
+		.b = false,
+		.b_exist = true,
+		.i = INT_MIN,
+		.i_exist = true,
+		.l = INT64_MIN,
+		.l_exist = true,
+		.d = d,
+		.d_exist = true,
+		.s_exist = true,
+		.arr = {INT_MIN, INT_MIN, INT_MIN},
+		.arr_exist = true,
+		.arr_count = 3,
+	};
+	memset(input.s, '\x01', sizeof(input.s));
+
+	bo_json_simple_writer_init(&writer, actual, sizeof(actual));
+	err = bo_json_encode(&input, &worst_desc, &writer.ctx);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	TEST_ASSERT_EQUAL(max_size, writer.len);
+
+	// descriptors which cannot be encoded have no bound
+	const struct bo_json_value_desc null_desc = {.type = BO_JSON_VALUE_TYPE_NULL};
+
+	err = bo_json_max_encoded_size(&null_desc, &max_size);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NOT_SUPPORT, err.err);
+}
+
+// chunk by chunk, the step encoder writes what bo_json_encode writes at once
+static void check_step_encoder(const void *input, const struct bo_json_value_desc *desc)
+{
+	static char expect[4096];
+	static char actual[sizeof(expect)];
+	struct bo_json_simple_writer writer;
+	struct bo_json_error err;
+
+	bo_json_simple_writer_init(&writer, expect, sizeof(expect));
+	err = bo_json_encode(input, desc, &writer.ctx);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+
+	for (size_t cap = 1; cap <= 513; cap = (cap < 48) ? cap + 1 : cap * 2 + 1) {
+		struct bo_json_encoder encoder;
+		size_t len = 0;
+		size_t written;
+
+		sprintf(error_message, "chunk %zu", cap);
+		bo_json_encoder_init(&encoder, input, desc);
+
+		do {
+			err = bo_json_encoder_step(&encoder, actual + len, cap, &written);
+			len += written;
+			TEST_ASSERT_TRUE_MESSAGE(written == cap || err.err == BO_JSON_ERROR_NONE,
+						 error_message);
+		} while (err.err == BO_JSON_ERROR_PARTIAL && len <= writer.len);
+
+		TEST_ASSERT_EQUAL_MESSAGE(BO_JSON_ERROR_NONE, err.err, error_message);
+		TEST_ASSERT_EQUAL_MESSAGE(writer.len, len, error_message);
+		TEST_ASSERT_EQUAL_STRING_LEN_MESSAGE(expect, actual, len, error_message);
+
+		// nothing follows a complete value
+		err = bo_json_encoder_step(&encoder, actual, cap, &written);
+		TEST_ASSERT_EQUAL_MESSAGE(BO_JSON_ERROR_NONE, err.err, error_message);
+		TEST_ASSERT_EQUAL_MESSAGE(0, written, error_message);
+	}
+}
+
+void test_encode_step(void)
+{
+	const struct obj_root nest = {
+		.nest1_exist = true,
+		.nest1 = {.nest2_exist = true,
+			  .nest2 = {.t = true,
+				    .t_exist = true,
+				    .negative_double = -100.1,
+				    .negative_double_exist = true,
+				    .str = "boring \"json\"\n",
+				    .str_exist = true,
+				    .arr_integer = {0, 1, -1},
+				    .arr_integer_count = 3,
+				    .arr_integer_exist = true}},
+	};
+	check_step_encoder(&nest, &obj_root_desc);
+
+	const struct keys keys = {1, true, 2, true, 3, true};
+	check_step_encoder(&keys, &keys_desc);
+
+	struct worst worst = {
+		.b_exist = true,
+		.i = INT_MIN,
+		.i_exist = true,
+		.d = 0.1,
+		.d_exist = true,
+		.s_exist = true,
+		.arr_exist = true,
+	};
+	memset(worst.s, '\x1f', sizeof(worst.s));
+	check_step_encoder(&worst, &worst_desc);
+
+	struct array_strs {
+		char strs[3][64];
+		size_t strs_count;
+	} strs = {.strs = {"", "a long string without anything to escape in it", "\t"},
+		  .strs_count = 3};
+	const struct bo_json_value_desc str_desc = BO_JSON_VALUE_CSTR(64);
+	const struct bo_json_value_desc strs_desc =
+		BO_JSON_VALUE_STRUCT_ARRAY(struct array_strs, strs, &str_desc, 3, strs_count);
+	check_step_encoder(&strs, &strs_desc);
+
+	struct bo_json_encoder encoder;
+	char buf[16];
+	size_t written;
+	struct bo_json_error err;
+
+	// errors stop the encoding, after what was written before
+	worst.d = NAN;
+	bo_json_encoder_init(&encoder, &worst, &worst_desc);
+	do {
+		err = bo_json_encoder_step(&encoder, buf, sizeof(buf), &written);
+	} while (err.err == BO_JSON_ERROR_PARTIAL);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_CONVERT, err.err);
+
+	// an array which is its own element nests deeper than the stack
+	const size_t count = 1;
+	const struct bo_json_value_desc self_desc = {
+		.type = BO_JSON_VALUE_TYPE_ARRAY,
+		.array = {.elem_attr_desc = &self_desc, .elem_size = 0, .capacity = 1},
+	};
+	bo_json_encoder_init(&encoder, &count, &self_desc);
+	err = bo_json_encoder_step(&encoder, buf, sizeof(buf), &written);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_OVERFLOW, err.err);
+	TEST_ASSERT_EQUAL(BO_JSON_ENCODER_MAX_DEPTH, written);
+}
+
+void test_encode_parallel(void)
+{
+	struct records {
+		struct prims values[3000];
+		size_t values_count;
+	};
+
+	static struct records input;
+	static char expect[3000 * 256];
+	static char actual[sizeof(expect)];
+
+	const struct bo_json_value_desc record_desc = BO_JSON_VALUE_OBJECT(prims_attrs);
+	const struct bo_json_value_desc records_desc = BO_JSON_VALUE_STRUCT_ARRAY(
+		struct records, values, &record_desc, 3000, values_count);
+
+	for (size_t i = 0; i < BO_ARRAY_SIZE(input.values); i++) {
+		struct prims *value = &input.values[i];
+
+		value->positive_int = (int)i;
+		value->positive_int_exist = true;
+		value->negative_double = -(double)i / 3;
+		value->negative_double_exist = (i % 2) == 0;
+		sprintf(value->str, "record \"%zu\"", i);
+		value->str_exist = true;
+	}
+
+	struct bo_json_simple_writer simple;
+	struct bo_json_simple_writer writer;
+	struct bo_json_error err;
+
+	// segments of every size, down to arrays shorter than the number of threads
+	const size_t counts[] = {3000, 7, 2, 1, 0};
+	const size_t threads[] = {1, 2, 3, 8};
+
+	for (size_t c = 0; c < BO_ARRAY_SIZE(counts); c++) {
+		input.values_count = counts[c];
+
+		bo_json_simple_writer_init(&simple, expect, sizeof(expect));
+		err = bo_json_encode(&input, &records_desc, &simple.ctx);
+		TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+
+		for (size_t t = 0; t < BO_ARRAY_SIZE(threads); t++) {
+			sprintf(error_message, "%zu records, %zu threads", counts[c], threads[t]);
+
+			bo_json_simple_writer_init(&writer, actual, sizeof(actual));
+			err = bo_json_encode_parallel(&input, &records_desc, threads[t],
+						      &writer.ctx);
+			TEST_ASSERT_EQUAL_MESSAGE(BO_JSON_ERROR_NONE, err.err, error_message);
+			TEST_ASSERT_EQUAL_MESSAGE(simple.len, writer.len, error_message);
+			TEST_ASSERT_EQUAL_STRING_LEN_MESSAGE(expect, actual, writer.len,
+							     error_message);
+		}
+	}
+
+	// an error in any segment is reported
+	input.values_count = 3000;
+	input.values[2999].negative_double = NAN;
+	input.values[2999].negative_double_exist = true;
+	bo_json_simple_writer_init(&writer, actual, sizeof(actual));
+	err = bo_json_encode_parallel(&input, &records_desc, 4, &writer.ctx);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_CONVERT, err.err);
+
+	// only arrays are split
+	err = bo_json_encode_parallel(&input, &record_desc, 4, &writer.ctx);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NOT_SUPPORT, err.err);
+}
+
+void test_encode_ndjson(void)
+{
+	static struct prims input[200];
+	static char expect[200 * 256];
+	static char actual[sizeof(expect)];
+
+	const struct bo_json_value_desc record_desc = BO_JSON_VALUE_OBJECT(prims_attrs);
+
+	for (size_t i = 0; i < BO_ARRAY_SIZE(input); i++) {
+		input[i].positive_int = (int)i;
+		input[i].positive_int_exist = true;
+		sprintf(input[i].str, "line\n%zu", i);
+		input[i].str_exist = (i % 3) == 0;
+	}
+
+	struct bo_json_simple_writer simple;
+	struct bo_json_simple_writer writer;
+	struct counting_writer counting;
+	struct bo_json_error err;
+
+	bo_json_simple_writer_init(&simple, expect, sizeof(expect));
+	for (size_t i = 0; i < BO_ARRAY_SIZE(input); i++) {
+		err = bo_json_encode(&input[i], &record_desc, &simple.ctx);
+		TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+		err = bo_json_writer_write(&simple.ctx, "\n", 1);
+		TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	}
+
+	// straight into the window
+	bo_json_simple_writer_init(&writer, actual, sizeof(actual));
+	err = bo_json_encode_ndjson(input, sizeof(input[0]), BO_ARRAY_SIZE(input), &record_desc,
+				    &writer.ctx);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	TEST_ASSERT_EQUAL(simple.len, writer.len);
+	TEST_ASSERT_EQUAL_STRING_LEN(expect, actual, simple.len);
+
+	// a writer without a window receives whole blocks
+	bo_json_writer_init(&counting.ctx, counting_write);
+	bo_json_simple_writer_init(&counting.simple, actual, sizeof(actual));
+	counting.n_writes = 0;
+	err = bo_json_encode_ndjson(input, sizeof(input[0]), BO_ARRAY_SIZE(input), &record_desc,
+				    &counting.ctx);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	TEST_ASSERT_EQUAL(simple.len, counting.simple.len);
+	TEST_ASSERT_EQUAL_STRING_LEN(expect, actual, simple.len);
+	TEST_ASSERT_TRUE(simple.len > BO_JSON_NDJSON_BLOCK_SIZE);
+	TEST_ASSERT_TRUE(counting.n_writes <= (simple.len / (BO_JSON_NDJSON_BLOCK_SIZE - 64)) + 1);
+
+	// nothing to encode
+	counting.n_writes = 0;
+	err = bo_json_encode_ndjson(input, sizeof(input[0]), 0, &record_desc, &counting.ctx);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	TEST_ASSERT_EQUAL(0, counting.n_writes);
+
+	// the first failing element stops the encoding
+	input[5].negative_double = NAN;
+	input[5].negative_double_exist = true;
+	bo_json_simple_writer_init(&writer, actual, sizeof(actual));
+	err = bo_json_encode_ndjson(input, sizeof(input[0]), BO_ARRAY_SIZE(input), &record_desc,
+				    &writer.ctx);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_CONVERT, err.err);
+	input[5].negative_double_exist = false;
+
+	// past the first block, the lines before the failing element still reach the writer,
+	// along with the part of it encoded before the error
+	input[190].negative_double = NAN;
+	input[190].negative_double_exist = true;
+	bo_json_simple_writer_init(&simple, expect, sizeof(expect));
+	for (size_t i = 0; i < 190; i++) {
+		err = bo_json_encode(&input[i], &record_desc, &simple.ctx);
+		TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+		err = bo_json_writer_write(&simple.ctx, "\n", 1);
+		TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	}
+	TEST_ASSERT_TRUE(simple.len > BO_JSON_NDJSON_BLOCK_SIZE);
+	err = bo_json_encode(&input[190], &record_desc, &simple.ctx);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_CONVERT, err.err);
+
+	bo_json_simple_writer_init(&writer, actual, sizeof(actual));
+	err = bo_json_encode_ndjson(input, sizeof(input[0]), BO_ARRAY_SIZE(input), &record_desc,
+				    &writer.ctx);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_CONVERT, err.err);
+	TEST_ASSERT_EQUAL(simple.len, writer.len);
+	TEST_ASSERT_EQUAL_STRING_LEN(expect, actual, simple.len);
+
+	bo_json_simple_writer_init(&counting.simple, actual, sizeof(actual));
+	err = bo_json_encode_ndjson(input, sizeof(input[0]), BO_ARRAY_SIZE(input), &record_desc,
+				    &counting.ctx);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_CONVERT, err.err);
+	TEST_ASSERT_EQUAL(simple.len, counting.simple.len);
+	TEST_ASSERT_EQUAL_STRING_LEN(expect, actual, simple.len);
+}
+
+static void delta_keep(struct obj_nest_2 *value)
+{
+	(void)value;
+}
+
+static void delta_set_int(struct obj_nest_2 *value)
+{
+	value->positive_int = 5;
+}
+
+static void delta_add_bool(struct obj_nest_2 *value)
+{
+	value->t = true;
+	value->t_exist = true;
+}
+
+static void delta_remove_str(struct obj_nest_2 *value)
+{
+	value->str_exist = false;
+}
+
+static void delta_set_elem(struct obj_nest_2 *value)
+{
+	value->arr_integer[1] = -2;
+}
+
+static void delta_set_several(struct obj_nest_2 *value)
+{
+	value->positive_int = 5;
+	strcpy(value->str, "other");
+}
+
+void test_encode_delta(void)
+{
+	struct obj_root prev = {
+		.nest1_exist = true,
+		.nest1.nest2_exist = true,
+		.nest1.nest2 = {
+			.f_exist = true,
+			.positive_int = 100,
+			.positive_int_exist = true,
+			.negative_double = NAN,
+			.negative_double_exist = true,
+			.str = "boring json",
+			.str_exist = true,
+			.arr_integer = {1, 2, 3},
+			.arr_integer_count = 3,
+			.arr_integer_exist = true,
+		},
+	};
+
+	const struct {
+		void (*change)(struct obj_nest_2 *value);
+		const char *expect;
+	} cases[] = {
+		{delta_keep, "{}"},
+		{delta_set_int, "{\"nest1\":{\"nest2\":{\"positive_int\":5}}}"},
+		{delta_add_bool, "{\"nest1\":{\"nest2\":{\"t\":true}}}"},
+		{delta_remove_str, "{\"nest1\":{\"nest2\":{\"str\":null}}}"},
+		{delta_set_elem, "{\"nest1\":{\"nest2\":{\"arr_integer\":[1,-2,3]}}}"},
+		{delta_set_several,
+		 "{\"nest1\":{\"nest2\":{\"positive_int\":5,\"str\":\"other\"}}}"},
+	};
+
+	for (size_t i = 0; i < BO_ARRAY_SIZE(cases); i++) {
+		struct obj_root value = prev;
+		char actual[128];
+		struct bo_json_simple_writer writer;
+
+		sprintf(error_message, "case %zu", i);
+		cases[i].change(&value.nest1.nest2);
+
+		bo_json_simple_writer_init(&writer, actual, sizeof(actual));
+		struct bo_json_error err =
+			bo_json_encode_delta(&value, &prev, &obj_root_desc, &writer.ctx);
+		TEST_ASSERT_EQUAL_MESSAGE(BO_JSON_ERROR_NONE, err.err, error_message);
+		TEST_ASSERT_EQUAL_MESSAGE(strlen(cases[i].expect), writer.len, error_message);
+		TEST_ASSERT_EQUAL_STRING_LEN_MESSAGE(cases[i].expect, actual, writer.len,
+						     error_message);
+	}
+
+	// an object which appears is written whole
+	struct obj_root value = prev;
+	char actual[256];
+	struct bo_json_simple_writer writer;
+	struct bo_json_error err;
+
+	prev.nest1.nest2_exist = false;
+	value.nest1.nest2.negative_double = 1.5;
+	bo_json_simple_writer_init(&writer, actual, sizeof(actual));
+	err = bo_json_encode_delta(&value, &prev, &obj_root_desc, &writer.ctx);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+
+	const char expect[] = "{\"nest1\":{\"nest2\":{\"f\":false,\"positive_int\":100,"
+			      "\"negative_double\":1.5,\"str\":\"boring json\","
+			      "\"arr_integer\":[1,2,3]}}}";
+	TEST_ASSERT_EQUAL(strlen(expect), writer.len);
+	TEST_ASSERT_EQUAL_STRING_LEN(expect, actual, writer.len);
+}
+
+struct cached_msg {
+	int seq;
+	bool seq_exist;
+
+	struct obj_nest_2 meta;
+	bool meta_exist;
+};
+
+static const struct bo_json_obj_attr_desc cached_msg_attrs[] = {
+	BO_JSON_OBJECT_ATTR_INT(struct cached_msg, seq),
+	BO_JSON_OBJECT_ATTR_OBJECT_CACHED(struct cached_msg, meta, obj_nest_2_attrs),
+};
+
+static const struct bo_json_value_desc cached_msg_desc = BO_JSON_VALUE_OBJECT(cached_msg_attrs);
+
+void test_encode_cached(void)
+{
+	struct cached_msg msg = {
+		.seq_exist = true,
+		.meta_exist = true,
+		.meta = {.positive_int = 7, .positive_int_exist = true, .str = "device",
+			 .str_exist = true},
+	};
+
+	struct bo_json_cache_entry entries[2];
+	char buf[128];
+	struct bo_json_cache cache;
+	char actual[128];
+	struct bo_json_simple_writer writer;
+	struct bo_json_error err;
+
+	bo_json_cache_init(&cache, entries, BO_ARRAY_SIZE(entries), buf, sizeof(buf));
+
+	const char expect[] = "{\"seq\":1,\"meta\":{\"positive_int\":7,\"str\":\"device\"}}";
+	msg.seq = 1;
+	bo_json_simple_writer_init(&writer, actual, sizeof(actual));
+	err = bo_json_encode_cached(&msg, &cached_msg_desc, &cache, &writer.ctx);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	TEST_ASSERT_EQUAL(strlen(expect), writer.len);
+	TEST_ASSERT_EQUAL_STRING_LEN(expect, actual, writer.len);
+	TEST_ASSERT_EQUAL(1, cache.n_used);
+
+	// the cached bytes are written until the next generation
+	const char stale[] = "{\"seq\":2,\"meta\":{\"positive_int\":7,\"str\":\"device\"}}";
+	msg.seq = 2;
+	msg.meta.positive_int = 8;
+	bo_json_simple_writer_init(&writer, actual, sizeof(actual));
+	err = bo_json_encode_cached(&msg, &cached_msg_desc, &cache, &writer.ctx);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	TEST_ASSERT_EQUAL_STRING_LEN(stale, actual, writer.len);
+	TEST_ASSERT_EQUAL(1, cache.n_used);
+
+	// a new generation encodes the object again, into the same entry
+	const char fresh[] = "{\"seq\":2,\"meta\":{\"positive_int\":8,\"str\":\"device\"}}";
+	bo_json_cache_bump(&cache);
+	TEST_ASSERT_EQUAL(1, cache.generation);
+	bo_json_simple_writer_init(&writer, actual, sizeof(actual));
+	err = bo_json_encode_cached(&msg, &cached_msg_desc, &cache, &writer.ctx);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	TEST_ASSERT_EQUAL_STRING_LEN(fresh, actual, writer.len);
+	TEST_ASSERT_EQUAL(1, cache.n_used);
+	TEST_ASSERT_EQUAL(1, entries[0].generation);
+	TEST_ASSERT_EQUAL(0, entries[0].offset);
+
+	// an object which grew past its bytes moves behind the others
+	struct cached_msg other = msg;
+	const char grown[] =
+		"{\"seq\":2,\"meta\":{\"positive_int\":8,\"str\":\"another device\"}}";
+
+	bo_json_simple_writer_init(&writer, actual, sizeof(actual));
+	err = bo_json_encode_cached(&other, &cached_msg_desc, &cache, &writer.ctx);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	TEST_ASSERT_EQUAL_STRING_LEN(fresh, actual, writer.len);
+	TEST_ASSERT_EQUAL(2, cache.n_used);
+
+	strcpy(msg.meta.str, "another device");
+	bo_json_cache_bump(&cache);
+	bo_json_simple_writer_init(&writer, actual, sizeof(actual));
+	err = bo_json_encode_cached(&msg, &cached_msg_desc, &cache, &writer.ctx);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	TEST_ASSERT_EQUAL_STRING_LEN(grown, actual, writer.len);
+	TEST_ASSERT_EQUAL(entries[1].offset + entries[1].cap, entries[0].offset);
+	bo_json_simple_writer_init(&writer, actual, sizeof(actual));
+	err = bo_json_encode_cached(&other, &cached_msg_desc, &cache, &writer.ctx);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	TEST_ASSERT_EQUAL_STRING_LEN(fresh, actual, writer.len);
+	strcpy(msg.meta.str, "device");
+
+	// objects which do not fit are encoded directly, without trying the cache again until the
+	// next generation
+	bo_json_cache_init(&cache, entries, BO_ARRAY_SIZE(entries), buf, 16);
+	bo_json_simple_writer_init(&writer, actual, sizeof(actual));
+	err = bo_json_encode_cached(&msg, &cached_msg_desc, &cache, &writer.ctx);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	TEST_ASSERT_EQUAL_STRING_LEN(fresh, actual, writer.len);
+	TEST_ASSERT_EQUAL(1, cache.n_used);
+	TEST_ASSERT_TRUE(entries[0].too_large);
+	TEST_ASSERT_EQUAL(0, cache.used);
+
+	char untouched[16];
+
+	memset(untouched, '#', sizeof(untouched));
+	memcpy(buf, untouched, sizeof(untouched));
+	bo_json_simple_writer_init(&writer, actual, sizeof(actual));
+	err = bo_json_encode_cached(&msg, &cached_msg_desc, &cache, &writer.ctx);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	TEST_ASSERT_EQUAL_STRING_LEN(fresh, actual, writer.len);
+	TEST_ASSERT_EQUAL_MEMORY(untouched, buf, sizeof(untouched));
+
+	bo_json_cache_init(&cache, entries, 0, buf, sizeof(buf));
+	bo_json_simple_writer_init(&writer, actual, sizeof(actual));
+	err = bo_json_encode_cached(&msg, &cached_msg_desc, &cache, &writer.ctx);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	TEST_ASSERT_EQUAL_STRING_LEN(fresh, actual, writer.len);
+
+	// without a cache the flag changes nothing
+	bo_json_simple_writer_init(&writer, actual, sizeof(actual));
+	err = bo_json_encode(&msg, &cached_msg_desc, &writer.ctx);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	TEST_ASSERT_EQUAL_STRING_LEN(fresh, actual, writer.len);
+}
+
+void test_encode_template(void)
+{
+	struct obj_root input = {
+		.nest1_exist = true,
+		.nest1.nest2_exist = true,
+		.nest1.nest2 = {
+			.f_exist = true,
+			.t = true,
+			.t_exist = true,
+			.positive_int = 100,
+			.positive_int_exist = true,
+			.negative_int = -100,
+			.negative_int_exist = true,
+			.positive_double = 100.1,
+			.positive_double_exist = true,
+			.negative_double = -100.1,
+			.negative_double_exist = true,
+			.str = "boring \"json\"",
+			.str_exist = true,
+			.arr_integer = {0, 1, -1},
+			.arr_integer_count = 3,
+			.arr_integer_exist = true,
+		},
+	};
+
+	struct bo_json_template_hole holes[8];
+	char literals[128];
+	struct bo_json_template tmpl;
+	char expect[256];
+	char actual[256];
+	struct bo_json_simple_writer writer;
+	struct bo_json_error err;
+
+	bo_json_simple_writer_init(&writer, expect, sizeof(expect));
+	err = bo_json_encode(&input, &obj_root_desc, &writer.ctx);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	const size_t expect_len = writer.len;
+
+	err = bo_json_template_build(&tmpl, &obj_root_desc, holes, BO_ARRAY_SIZE(holes), literals,
+				     sizeof(literals));
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	TEST_ASSERT_EQUAL(8, tmpl.n_holes);
+
+	bo_json_simple_writer_init(&writer, actual, sizeof(actual));
+	err = bo_json_template_encode(&tmpl, &input, &writer.ctx);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	TEST_ASSERT_EQUAL(expect_len, writer.len);
+	TEST_ASSERT_EQUAL_STRING_LEN(expect, actual, writer.len);
+
+	// presence flags are not read
+	input.nest1.nest2.f_exist = false;
+	bo_json_simple_writer_init(&writer, actual, sizeof(actual));
+	err = bo_json_template_encode(&tmpl, &input, &writer.ctx);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	TEST_ASSERT_EQUAL_STRING_LEN(expect, actual, writer.len);
+
+	// a value which is not an object is a single hole
+	const int number = 42;
+	err = bo_json_template_build(&tmpl, &bo_json_int_desc, holes, 1, literals, 0);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	bo_json_simple_writer_init(&writer, actual, sizeof(actual));
+	err = bo_json_template_encode(&tmpl, &number, &writer.ctx);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	TEST_ASSERT_EQUAL_STRING_LEN("42", actual, writer.len);
+
+	err = bo_json_template_build(&tmpl, &obj_root_desc, holes, 7, literals, sizeof(literals));
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_INSUFFICIENT_SPACE, err.err);
+	err = bo_json_template_build(&tmpl, &obj_root_desc, holes, BO_ARRAY_SIZE(holes), literals,
+				     16);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_INSUFFICIENT_SPACE, err.err);
+}
+
+struct row {
+	int id;
+	bool id_exist;
+
+	char name[16];
+	bool name_exist;
+};
+
+static const struct bo_json_obj_attr_desc row_attrs[] = {
+	BO_JSON_OBJECT_ATTR_INT(struct row, id),
+	BO_JSON_OBJECT_ATTR_CSTR_ARRAY(struct row, name),
+};
+
+static const struct bo_json_value_desc row_desc = BO_JSON_VALUE_OBJECT(row_attrs);
+
+struct row_cursor {
+	int next;
+	int end;
+	int fail_at;
+};
+
+static int next_row(void *ctx, void *elem)
+{
+	struct row_cursor *cursor = ctx;
+	struct row *row = elem;
+
+	if (cursor->next == cursor->fail_at) {
+		return -EIO;
+	}
+	if (cursor->next == cursor->end) {
+		return 0;
+	}
+
+	row->id = cursor->next;
+	row->id_exist = true;
+	sprintf(row->name, "row %d", cursor->next);
+	row->name_exist = (cursor->next % 2) == 0;
+	cursor->next++;
+	return 1;
+}
+
+struct discard_writer {
+	struct bo_json_writer ctx;
+	size_t len;
+};
+
+static struct bo_json_error discard_write(struct bo_json_writer *writer, const void *data,
+					  size_t len)
+{
+	(void)data;
+	((struct discard_writer *)writer)->len += len;
+	return BO_JSON_OK();
+}
+
+struct table {
+	int version;
+	bool version_exist;
+
+	struct row rows;
+	bool rows_exist;
+	void *cursor;
+};
+
+static const struct bo_json_obj_attr_desc table_attrs[] = {
+	BO_JSON_OBJECT_ATTR_INT(struct table, version),
+	BO_JSON_OBJECT_ATTR_GENERATOR(struct table, rows, &row_desc, next_row, cursor),
+};
+
+static const struct bo_json_value_desc table_desc = BO_JSON_VALUE_OBJECT(table_attrs);
+
+struct long_row {
+	char name[BO_JSON_IOVEC_WRITER_REF_MIN + 32];
+	bool name_exist;
+};
+
+static const struct bo_json_obj_attr_desc long_row_attrs[] = {
+	BO_JSON_OBJECT_ATTR_CSTR_ARRAY(struct long_row, name),
+};
+
+static const struct bo_json_value_desc long_row_desc = BO_JSON_VALUE_OBJECT(long_row_attrs);
+
+static int next_long_row(void *ctx, void *elem)
+{
+	struct row_cursor *cursor = ctx;
+	struct long_row *row = elem;
+
+	if (cursor->next == cursor->end) {
+		return 0;
+	}
+
+	// long enough to be referenced by the iovec writer, if it were allowed to
+	memset(row->name, 'a' + cursor->next, BO_JSON_IOVEC_WRITER_REF_MIN + 16);
+	row->name[BO_JSON_IOVEC_WRITER_REF_MIN + 16] = '\0';
+	row->name_exist = true;
+	cursor->next++;
+	return 1;
+}
+
+struct long_table {
+	struct long_row rows;
+	bool rows_exist;
+	void *cursor;
+};
+
+static const struct bo_json_obj_attr_desc long_table_attrs[] = {
+	BO_JSON_OBJECT_ATTR_GENERATOR(struct long_table, rows, &long_row_desc, next_long_row,
+				      cursor),
+};
+
+static const struct bo_json_value_desc long_table_desc = BO_JSON_VALUE_OBJECT(long_table_attrs);
+
+void test_encode_generator(void)
+{
+	struct row_cursor cursor;
+	struct table table = {
+		.version = 3,
+		.version_exist = true,
+		.rows_exist = true,
+		.cursor = &cursor,
+	};
+
+	const struct {
+		int end;
+		int fail_at;
+		enum bo_json_error_code err;
+		const char *expect;
+	} cases[] = {
+		{0, -1, BO_JSON_ERROR_NONE, "{\"version\":3,\"rows\":[]}"},
+		{1, -1, BO_JSON_ERROR_NONE,
+		 "{\"version\":3,\"rows\":[{\"id\":0,\"name\":\"row 0\"}]}"},
+		{3, -1, BO_JSON_ERROR_NONE,
+		 "{\"version\":3,\"rows\":[{\"id\":0,\"name\":\"row 0\"},{\"id\":1},"
+		 "{\"id\":2,\"name\":\"row 2\"}]}"},
+		{3, 2, BO_JSON_ERROR_IO, NULL},
+	};
+
+	for (size_t i = 0; i < BO_ARRAY_SIZE(cases); i++) {
+		char actual[128];
+		struct bo_json_simple_writer writer;
+
+		sprintf(error_message, "case %zu", i);
+		cursor.next = 0;
+		cursor.end = cases[i].end;
+		cursor.fail_at = cases[i].fail_at;
+
+		bo_json_simple_writer_init(&writer, actual, sizeof(actual));
+		struct bo_json_error err = bo_json_encode(&table, &table_desc, &writer.ctx);
+		TEST_ASSERT_EQUAL_MESSAGE(cases[i].err, err.err, error_message);
+		if (cases[i].expect != NULL) {
+			TEST_ASSERT_EQUAL_MESSAGE(strlen(cases[i].expect), writer.len,
+						  error_message);
+			TEST_ASSERT_EQUAL_STRING_LEN_MESSAGE(cases[i].expect, actual, writer.len,
+							     error_message);
+		}
+	}
+
+	// a generator as the encoded value, memory stays the same for any number of rows
+	const struct bo_json_value_desc rows_desc =
+		BO_JSON_VALUE_STRUCT_GENERATOR(struct table, rows, &row_desc, next_row, cursor);
+	struct discard_writer discard;
+
+	cursor.next = 0;
+	cursor.end = 10000;
+	cursor.fail_at = -1;
+	bo_json_writer_init(&discard.ctx, discard_write);
+	discard.len = 0;
+	struct bo_json_error err = bo_json_encode(&table, &rows_desc, &discard.ctx);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	TEST_ASSERT_EQUAL(10000, cursor.next);
+	TEST_ASSERT_TRUE(discard.len > 10000 * sizeof("{\"id\":0},"));
+
+	// the elements cannot be counted without producing them
+	size_t size;
+	err = bo_json_encoded_size(&table, &rows_desc, &size);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NOT_SUPPORT, err.err);
+
+	// an element is overwritten by the next one, so the writer must copy it
+	struct long_table long_table = {.rows_exist = true, .cursor = &cursor};
+	static char expect[4 * (BO_JSON_IOVEC_WRITER_REF_MIN + 32)];
+	static char actual[sizeof(expect)];
+	struct bo_json_simple_writer simple;
+	struct iovec iov[16];
+	char buf[256];
+	int fds[2];
+	struct bo_json_iovec_writer iovec;
+
+	cursor.next = 0;
+	cursor.end = 3;
+	bo_json_simple_writer_init(&simple, expect, sizeof(expect));
+	err = bo_json_encode(&long_table, &long_table_desc, &simple.ctx);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+
+	cursor.next = 0;
+	TEST_ASSERT_EQUAL(0, pipe(fds));
+	bo_json_iovec_writer_init(&iovec, fds[1], iov, BO_ARRAY_SIZE(iov), buf, sizeof(buf));
+	err = bo_json_encode(&long_table, &long_table_desc, &iovec.ctx);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	TEST_ASSERT_NOT_NULL(iovec.ctx.write_ref);
+	err = bo_json_iovec_writer_flush(&iovec);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	close(fds[1]);
+
+	size_t len = 0;
+	ssize_t ret;
+
+	while ((ret = read(fds[0], actual + len, sizeof(actual) - len)) > 0) {
+		len += (size_t)ret;
+	}
+	close(fds[0]);
+
+	TEST_ASSERT_EQUAL(simple.len, len);
+	TEST_ASSERT_EQUAL_STRING_LEN(expect, actual, len);
+}
+
+void test_encode_projection(void)
+{
+	struct obj_root input = {
+		.nest1_exist = true,
+		.nest1.nest2_exist = true,
+		.nest1.nest2 = {
+			.f_exist = true,
+			.t = true,
+			.t_exist = true,
+			.positive_int = 100,
+			.positive_int_exist = true,
+			.negative_int = -100,
+			.negative_int_exist = true,
+			.str = "boring json",
+			.str_exist = true,
+			.arr_integer = {0, 1},
+			.arr_integer_count = 2,
+			.arr_integer_exist = true,
+		},
+	};
+
+	// obj_nest_2_attrs: [1] t, [2] positive_int, [6] str
+	const struct bo_json_projection nest2_proj = {
+		.mask = BO_JSON_PROJECTION_BIT(1) | BO_JSON_PROJECTION_BIT(2) |
+			BO_JSON_PROJECTION_BIT(6),
+	};
+	const struct bo_json_projection *const nest1_children[] = {&nest2_proj};
+	const struct bo_json_projection nest1_proj = {
+		.mask = BO_JSON_PROJECTION_ALL,
+		.attrs = nest1_children,
+	};
+	const struct bo_json_projection *const root_children[] = {&nest1_proj};
+	const struct bo_json_projection root_proj = {
+		.mask = BO_JSON_PROJECTION_ALL,
+		.attrs = root_children,
+	};
+	const struct bo_json_projection none_proj = {.mask = 0};
+
+	const struct {
+		const struct bo_json_projection *proj;
+		const char *expect;
+	} cases[] = {
+		{&root_proj, "{\"nest1\":{\"nest2\":{\"t\":true,\"positive_int\":100,"
+			     "\"str\":\"boring json\"}}}"},
+		// one level up, nest2 is not selected in nest1
+		{&nest1_proj, "{\"nest1\":{}}"},
+		{NULL, "{\"nest1\":{\"nest2\":{\"f\":false,\"t\":true,\"positive_int\":100,"
+		       "\"negative_int\":-100,\"str\":\"boring json\",\"arr_integer\":[0,1]}}}"},
+		{&none_proj, "{}"},
+	};
+
+	for (size_t i = 0; i < BO_ARRAY_SIZE(cases); i++) {
+		char actual[256];
+		struct bo_json_simple_writer writer;
+
+		sprintf(error_message, "case %zu", i);
+
+		bo_json_simple_writer_init(&writer, actual, sizeof(actual));
+		struct bo_json_error err =
+			bo_json_encode_ex(&input, &obj_root_desc, cases[i].proj, &writer.ctx);
+		TEST_ASSERT_EQUAL_MESSAGE(BO_JSON_ERROR_NONE, err.err, error_message);
+		TEST_ASSERT_EQUAL_MESSAGE(strlen(cases[i].expect), writer.len, error_message);
+		TEST_ASSERT_EQUAL_STRING_LEN_MESSAGE(cases[i].expect, actual, writer.len,
+						     error_message);
+	}
+
+	// the projection of an array applies to each element, prims_attrs: [2] positive_int
+	struct array_prims {
+		struct prims values[2];
+		size_t values_count;
+	} prims = {
+		.values = {{.positive_int = 1, .positive_int_exist = true, .t_exist = true},
+			   {.positive_int = 2, .positive_int_exist = true}},
+		.values_count = 2,
+	};
+	const struct bo_json_value_desc prim_desc = BO_JSON_VALUE_OBJECT(prims_attrs);
+	const struct bo_json_value_desc prims_desc =
+		BO_JSON_VALUE_STRUCT_ARRAY(struct array_prims, values, &prim_desc, 2, values_count);
+	const struct bo_json_projection int_proj = {.mask = BO_JSON_PROJECTION_BIT(2)};
+	const char expect[] = "[{\"positive_int\":1},{\"positive_int\":2}]";
+	char actual[64];
+	struct bo_json_simple_writer writer;
+
+	bo_json_simple_writer_init(&writer, actual, sizeof(actual));
+	struct bo_json_error err = bo_json_encode_ex(&prims, &prims_desc, &int_proj, &writer.ctx);
+	TEST_ASSERT_EQUAL(BO_JSON_ERROR_NONE, err.err);
+	TEST_ASSERT_EQUAL(strlen(expect), writer.len);
+	TEST_ASSERT_EQUAL_STRING_LEN(expect, actual, writer.len);
+}